@@ -1,4 +1,5 @@
 #include "order_book.hpp"
+#include <array>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -101,6 +102,29 @@ int main() {
 
     PrintResult(AnalyzeLatencies("Update()", update_latencies));
 
+    // Benchmark: Update on a book with compile-time precision and geometry
+    std::cout << "Benchmarking StaticOrderBook Update() (" << kBenchmarkIterations << " operations)...\n";
+    StaticOrderBook<2, 8, OrderBook::kDefaultLadderTicks> static_book("BTCUSDT");
+    for (size_t i = 0; i < kWarmupIterations; ++i) {
+        static_book.Update(static_cast<Side>(side_dist(gen)), price_dist(gen), qty_dist(gen));
+    }
+
+    std::vector<int64_t> static_update_latencies;
+    static_update_latencies.reserve(kBenchmarkIterations);
+
+    for (size_t i = 0; i < kBenchmarkIterations; ++i) {
+        Side side = static_cast<Side>(side_dist(gen));
+        Price price = price_dist(gen);
+        Quantity qty = qty_dist(gen);
+
+        int64_t ns = MeasureNanos([&]() {
+            static_book.Update(side, price, qty);
+        });
+        static_update_latencies.push_back(ns);
+    }
+
+    PrintResult(AnalyzeLatencies("Update() [static]", static_update_latencies));
+
     // Benchmark: GetBestBid
     std::cout << "Benchmarking GetBestBid() (" << kBenchmarkIterations << " operations)...\n";
     std::vector<int64_t> best_bid_latencies;
@@ -157,6 +181,24 @@ int main() {
 
     PrintResult(AnalyzeLatencies("GetTopLevels(5)", top_levels_latencies));
 
+    // Benchmark: GetTopLevels into a caller buffer (no allocation)
+    std::cout << "Benchmarking GetTopLevels(5) span (" << kBenchmarkIterations / 10 << " operations)...\n";
+    std::vector<int64_t> top_span_latencies;
+    top_span_latencies.reserve(kBenchmarkIterations / 10);
+    std::array<PriceLevel, 5> top_buffer;
+
+    for (size_t i = 0; i < kBenchmarkIterations / 10; ++i) {
+        Side side = static_cast<Side>(side_dist(gen));
+        
+        int64_t ns = MeasureNanos([&]() {
+            volatile auto result = book.GetTopLevels(side, top_buffer);
+            (void)result;
+        });
+        top_span_latencies.push_back(ns);
+    }
+
+    PrintResult(AnalyzeLatencies("GetTopLevels(5) span", top_span_latencies));
+
     // Benchmark: GetQuantityAt
     std::cout << "Benchmarking GetQuantityAt() (" << kBenchmarkIterations << " operations)...\n";
     std::vector<int64_t> qty_at_latencies;
@@ -175,6 +217,128 @@ int main() {
 
     PrintResult(AnalyzeLatencies("GetQuantityAt()", qty_at_latencies));
 
+    // Benchmark: remove the best bid and find the new top
+    std::cout << "Benchmarking best bid removal (" << kBenchmarkIterations << " operations)...\n";
+    std::vector<int64_t> remove_best_latencies;
+    remove_best_latencies.reserve(kBenchmarkIterations);
+
+    for (size_t i = 0; i < kBenchmarkIterations; ++i) {
+        Price best = *book.GetBestBid();
+        Quantity qty = book.GetQuantityAt(Side::kBuy, best);
+
+        int64_t ns = MeasureNanos([&]() {
+            book.Update(Side::kBuy, best, 0);
+            volatile auto result = book.GetBestBid();
+            (void)result;
+        });
+        remove_best_latencies.push_back(ns);
+
+        book.Update(Side::kBuy, best, qty);
+    }
+
+    PrintResult(AnalyzeLatencies("Remove best bid", remove_best_latencies));
+
+    // Benchmark: one 100-level depth message applied as a batch
+    constexpr size_t kBatchLevels = 100;
+    std::cout << "Benchmarking ApplyBatch(" << kBatchLevels << ") ("
+              << kBenchmarkIterations / 10 << " operations)...\n";
+    std::vector<int64_t> batch_latencies;
+    batch_latencies.reserve(kBenchmarkIterations / 10);
+    std::vector<LevelDelta> bid_batch(kBatchLevels / 2);
+    std::vector<LevelDelta> ask_batch(kBatchLevels / 2);
+
+    for (size_t i = 0; i < kBenchmarkIterations / 10; ++i) {
+        for (auto& delta : bid_batch) delta = {price_dist(gen), qty_dist(gen)};
+        for (auto& delta : ask_batch) delta = {price_dist(gen), qty_dist(gen)};
+
+        int64_t ns = MeasureNanos([&]() {
+            volatile auto result = book.ApplyBatch(bid_batch, ask_batch);
+            (void)result;
+        });
+        batch_latencies.push_back(ns);
+    }
+
+    PrintResult(AnalyzeLatencies("ApplyBatch(100)", batch_latencies));
+
+    // Benchmark: resync from a 5000-level-per-side snapshot, best-first as
+    // the REST API sends it: bulk LoadSnapshot() vs Clear() + Update() per level
+    constexpr size_t kSnapshotLevels = 5000;
+    constexpr int kSnapshotLoads = 100;
+    std::cout << "Benchmarking snapshot load (" << kSnapshotLevels << " levels per side, "
+              << kSnapshotLoads << " operations)...\n";
+    std::uniform_int_distribution<Price> gap_dist(1, 5);
+    std::vector<LevelDelta> snapshot_bids(kSnapshotLevels);
+    std::vector<LevelDelta> snapshot_asks(kSnapshotLevels);
+    Price bid_price = 5000000;
+    Price ask_price = 5000001;
+    for (size_t j = 0; j < kSnapshotLevels; ++j) {
+        snapshot_bids[j] = {bid_price, qty_dist(gen)};
+        snapshot_asks[j] = {ask_price, qty_dist(gen)};
+        bid_price -= gap_dist(gen);
+        ask_price += gap_dist(gen);
+    }
+
+    OrderBook snapshot_book("BTCUSDT", 2, 8);
+    snapshot_book.TrackDepth(10);
+    std::vector<int64_t> load_latencies;
+    std::vector<int64_t> replay_latencies;
+    for (int i = 0; i < kSnapshotLoads; ++i) {
+        load_latencies.push_back(MeasureNanos([&]() {
+            snapshot_book.LoadSnapshot(snapshot_bids, snapshot_asks, i);
+        }));
+        replay_latencies.push_back(MeasureNanos([&]() {
+            snapshot_book.Clear();
+            for (const auto& level : snapshot_bids) {
+                snapshot_book.Update(Side::kBuy, level.price, level.quantity);
+            }
+            for (const auto& level : snapshot_asks) {
+                snapshot_book.Update(Side::kSell, level.price, level.quantity);
+            }
+        }));
+    }
+
+    PrintResult(AnalyzeLatencies("LoadSnapshot(5000)", load_latencies));
+    PrintResult(AnalyzeLatencies("Clear + Update x 10000", replay_latencies));
+
+    // Benchmark: VWAP for a fixed size with the cumulative index enabled
+    book.EnableCumulativeIndex();
+    constexpr Quantity kSweepQuantity = 1000000000;  // 10 BTC
+    std::cout << "Benchmarking VwapForQuantity() (" << kBenchmarkIterations << " operations)...\n";
+    std::vector<int64_t> vwap_latencies;
+    vwap_latencies.reserve(kBenchmarkIterations);
+
+    for (size_t i = 0; i < kBenchmarkIterations; ++i) {
+        Side side = static_cast<Side>(side_dist(gen));
+        book.Update(side, price_dist(gen), qty_dist(gen));
+
+        int64_t ns = MeasureNanos([&]() {
+            volatile auto result = book.VwapForQuantity(side, kSweepQuantity);
+            (void)result;
+        });
+        vwap_latencies.push_back(ns);
+    }
+
+    PrintResult(AnalyzeLatencies("VwapForQuantity()", vwap_latencies));
+
+    // Benchmark: snapshot publish after 10 scattered updates (copy-on-write pages)
+    book.EnableSnapshots();
+    std::cout << "Benchmarking PublishSnapshot() (" << kBenchmarkIterations / 10 << " operations)...\n";
+    std::vector<int64_t> snapshot_latencies;
+    snapshot_latencies.reserve(kBenchmarkIterations / 10);
+
+    for (size_t i = 0; i < kBenchmarkIterations / 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            book.Update(static_cast<Side>(side_dist(gen)), price_dist(gen), qty_dist(gen));
+        }
+
+        int64_t ns = MeasureNanos([&]() {
+            book.PublishSnapshot();
+        });
+        snapshot_latencies.push_back(ns);
+    }
+
+    PrintResult(AnalyzeLatencies("PublishSnapshot()", snapshot_latencies));
+
     // Summary
     std::cout << "\n=== Summary ===\n";
     std::cout << "Total updates processed: " << book.GetUpdateCount() << "\n";
@@ -0,0 +1,204 @@
+#include "binance_messages.hpp"
+#include "depth_decoder.hpp"
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+
+using namespace hft;
+
+// Measure latency for a single operation
+template<typename Func>
+int64_t MeasureNanos(Func&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+struct BenchmarkResult {
+    std::string name;
+    double min_ns;
+    double mean_ns;
+    double median_ns;
+    double p99_ns;
+    double mb_per_sec;
+    size_t iterations;
+};
+
+void PrintResult(const BenchmarkResult& r) {
+    std::cout << std::left << std::setw(28) << r.name
+              << " | min: " << std::setw(7) << std::fixed << std::setprecision(0) << r.min_ns
+              << " | mean: " << std::setw(7) << r.mean_ns
+              << " | median: " << std::setw(7) << r.median_ns
+              << " | p99: " << std::setw(7) << r.p99_ns
+              << " ns | " << std::setw(6) << r.mb_per_sec << " MB/s"
+              << " (" << r.iterations << " messages)\n";
+}
+
+BenchmarkResult AnalyzeLatencies(const std::string& name,
+                                 std::vector<int64_t>& latencies,
+                                 size_t total_bytes) {
+    double sum = std::accumulate(latencies.begin(), latencies.end(), 0.0);
+    std::sort(latencies.begin(), latencies.end());
+    size_t n = latencies.size();
+
+    return BenchmarkResult{
+        .name = name,
+        .min_ns = static_cast<double>(latencies.front()),
+        .mean_ns = sum / n,
+        .median_ns = static_cast<double>(latencies[n / 2]),
+        .p99_ns = static_cast<double>(latencies[static_cast<size_t>(n * 0.99)]),
+        .mb_per_sec = sum > 0 ? total_bytes * 1000.0 / sum : 0.0,
+        .iterations = n
+    };
+}
+
+// One depthUpdate message per line, as received from the stream
+std::vector<simdjson::padded_string> LoadCorpus(const std::string& path) {
+    std::vector<simdjson::padded_string> corpus;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("depthUpdate") != std::string::npos) {
+            corpus.emplace_back(line);
+        }
+    }
+    return corpus;
+}
+
+// Binance-shaped depthUpdate messages with `levels` levels per side
+std::vector<simdjson::padded_string> SyntheticCorpus(size_t count, size_t levels) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> cents(0, 99);
+    std::uniform_int_distribution<int> offset(0, 2000);
+    std::uniform_int_distribution<int> lots(0, 99999999);
+
+    auto level = [&](int base, int sign) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "[\"%d.%02d000000\",\"%d.%08d\"]",
+                      base + sign * offset(gen), cents(gen), lots(gen) % 5, lots(gen));
+        return std::string(buf);
+    };
+
+    std::vector<simdjson::padded_string> corpus;
+    int64_t update_id = 50000000000;
+    for (size_t i = 0; i < count; ++i) {
+        std::string msg = "{\"e\":\"depthUpdate\",\"E\":1700000000000,\"s\":\"BTCUSDT\",\"U\":" +
+                          std::to_string(update_id) + ",\"u\":" +
+                          std::to_string(update_id + static_cast<int64_t>(levels)) + ",\"b\":[";
+        for (size_t j = 0; j < levels; ++j) {
+            if (j) msg += ',';
+            msg += level(30000, -1);
+        }
+        msg += "],\"a\":[";
+        for (size_t j = 0; j < levels; ++j) {
+            if (j) msg += ',';
+            msg += level(30001, 1);
+        }
+        msg += "]}";
+        update_id += static_cast<int64_t>(levels) + 1;
+        corpus.emplace_back(msg);
+    }
+    return corpus;
+}
+
+// Spot bookTicker messages
+std::vector<simdjson::padded_string> BookTickerCorpus(size_t count) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> cents(0, 99);
+    std::uniform_int_distribution<int> lots(0, 99999999);
+
+    std::vector<simdjson::padded_string> corpus;
+    for (size_t i = 0; i < count; ++i) {
+        char buf[256];
+        std::snprintf(buf, sizeof(buf),
+                      "{\"u\":%lld,\"s\":\"BTCUSDT\",\"b\":\"30000.%02d000000\",\"B\":\"%d.%08d\","
+                      "\"a\":\"30001.%02d000000\",\"A\":\"%d.%08d\"}",
+                      50000000000LL + static_cast<long long>(i), cents(gen), lots(gen) % 5,
+                      lots(gen), cents(gen), lots(gen) % 5, lots(gen));
+        corpus.emplace_back(std::string(buf));
+    }
+    return corpus;
+}
+
+template <typename ParseFn>
+void Run(const std::string& name,
+         const std::vector<simdjson::padded_string>& corpus,
+         size_t rounds,
+         ParseFn&& parse) {
+    size_t bytes = 0;
+    size_t failures = 0;
+    std::vector<int64_t> latencies;
+    latencies.reserve(corpus.size() * rounds);
+
+    for (size_t r = 0; r < rounds; ++r) {
+        for (const auto& msg : corpus) {
+            bool ok = false;
+            latencies.push_back(MeasureNanos([&]() { ok = parse(msg); }));
+            bytes += msg.size();
+            failures += !ok;
+        }
+    }
+
+    PrintResult(AnalyzeLatencies(name, latencies, bytes));
+    if (failures > 0) std::cout << "  (" << failures << " messages failed to parse)\n";
+}
+
+void RunAll(const std::vector<simdjson::padded_string>& corpus, size_t rounds) {
+    FastJsonParser parser;
+    DepthUpdateView view;
+    DepthDeltas deltas;
+
+    Run("FastJsonParser (view)", corpus, rounds, [&](const simdjson::padded_string& msg) {
+        return parser.ParseDepthUpdate(simdjson::padded_string_view(msg), view);
+    });
+    Run("FastJsonParser (fused)", corpus, rounds, [&](const simdjson::padded_string& msg) {
+        return parser.ParseDepthUpdate(simdjson::padded_string_view(msg), 2, 8, deltas);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Depth Parser Benchmark ===\n\n";
+
+    if (argc > 1) {
+        auto corpus = LoadCorpus(argv[1]);
+        if (corpus.empty()) {
+            std::cerr << "No depthUpdate messages in " << argv[1] << "\n";
+            return 1;
+        }
+        size_t total = 0;
+        for (const auto& msg : corpus) total += msg.size();
+        std::cout << "Corpus " << argv[1] << ": " << corpus.size() << " messages, "
+                  << total / corpus.size() << " bytes average\n";
+        RunAll(corpus, std::max<size_t>(1, 100000 / corpus.size()));
+        return 0;
+    }
+
+    // No corpus given: synthetic messages over typical depth@100ms sizes
+    for (size_t levels : {5, 20, 100, 250}) {
+        auto corpus = SyntheticCorpus(1000, levels);
+        std::cout << "Synthetic, " << levels << " levels per side ("
+                  << corpus.front().size() << " bytes):\n";
+        RunAll(corpus, 20);
+        std::cout << "\n";
+    }
+
+    auto tickers = BookTickerCorpus(1000);
+    std::cout << "Synthetic bookTicker (" << tickers.front().size() << " bytes):\n";
+    FastJsonParser parser;
+    BookTickerDecoder decoder;
+    BookTicker ticker;
+    Run("FastJsonParser", tickers, 100, [&](const simdjson::padded_string& msg) {
+        return parser.ParseBookTicker(simdjson::padded_string_view(msg), 2, 8, ticker);
+    });
+    Run("BookTickerDecoder", tickers, 100, [&](const simdjson::padded_string& msg) {
+        return decoder.Decode(simdjson::padded_string_view(msg), 2, 8, ticker);
+    });
+    return 0;
+}
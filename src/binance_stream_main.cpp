@@ -1,12 +1,18 @@
 #include "binance_client.hpp"
-#include "order_book.hpp"
-#include "latency_stats.hpp"
+#include "book_manager.hpp"
+#include "book_synchronizer.hpp"
+#include "disruptor.hpp"
+#include "feed_event.hpp"
+#include "latency_histogram.hpp"
 #include "strategy.hpp"
+#include <array>
 #include <iostream>
 #include <iomanip>
 #include <csignal>
 #include <atomic>
 #include <deque>
+#include <fstream>
+#include <memory>
 
 using namespace hft;
 
@@ -32,52 +38,146 @@ struct SignalLog {
     }
 };
 
-void PrintOrderBook(const OrderBook& book, 
-                    const LatencyStats& stats,
-                    const SpreadMonitorStrategy& spread_strategy,
-                    const ImbalanceStrategy& imbalance_strategy,
+// Running aggregate of the aggTrade tape (updated on the I/O thread)
+struct TradeTape {
+    uint64_t trades = 0;
+    Quantity buy_volume = 0;   // Taker buys
+    Quantity sell_volume = 0;  // Taker sells
+    TradeEvent last;
+    
+    void Add(const TradeEvent& trade) {
+        ++trades;
+        (trade.is_buyer_maker ? sell_volume : buy_volume) += trade.quantity;
+        last = trade;
+    }
+};
+
+// One slot of the ring between the I/O thread and the stages
+struct PipelineEvent {
+    FeedEvent feed;
+    
+    // Written by the book stage for the stages after it
+    bool refresh_display = false;  // A snapshot was published for this event
+    double spread_pct = 0.0;
+    double average_spread_pct = 0.0;
+    bool spread_alert = false;
+    double imbalance = 0.0;
+};
+
+// Ring slots; at depth@100ms plus tickers this is seconds of headroom
+constexpr size_t kRingCapacity = 4096;
+
+// One CSV line per event: receive time, kind, symbol, payload in fixed point
+void RecordEvent(std::ostream& out, const FeedEvent& event, const BookManager& books) {
+    out << event.received << ',';
+    switch (event.kind) {
+        case FeedEvent::Kind::kDepth: {
+            out << "depth," << books.Symbol(event.symbol_id) << ','
+                << event.first_update_id << ',' << event.final_update_id;
+            for (const auto* side : {&event.bids, &event.asks}) {
+                out << ',';
+                for (const LevelDelta& level : *side) {
+                    out << level.price << ':' << level.quantity << ';';
+                }
+            }
+            break;
+        }
+        case FeedEvent::Kind::kBookTicker:
+            out << "ticker," << books.Symbol(event.symbol_id) << ',' << event.ticker.update_id
+                << ',' << event.ticker.bid_price << ',' << event.ticker.bid_quantity
+                << ',' << event.ticker.ask_price << ',' << event.ticker.ask_quantity;
+            break;
+        case FeedEvent::Kind::kTrade:
+            out << "trade," << books.Symbol(event.symbol_id) << ',' << event.trade.trade_id
+                << ',' << event.trade.price << ',' << event.trade.quantity
+                << ',' << (event.trade.is_buyer_maker ? 'S' : 'B');
+            break;
+        case FeedEvent::Kind::kSnapshotReady:
+            out << "snapshot_ready," << books.Symbol(event.symbol_id);
+            break;
+    }
+    out << '\n';
+}
+
+// Display thread: reads the book only through its published snapshot and
+// top-of-book, never the live ladders
+void PrintOrderBook(const BookSnapshot& snapshot,
+                    const OrderBook& book,  // Symbol and precision
+                    const BookManager& books,
+                    const TradeTape& tape,
+                    const LatencyHistogram& stats,
+                    const PipelineEvent& event,
                     const SignalLog& signal_log) {
     std::cout << "\033[2J\033[H";  // Clear screen
     std::cout << "=== " << book.GetSymbol() << " Order Book + Strategy ===\n";
     std::cout << std::string(60, '-') << "\n";
     
-    auto asks = book.GetTopLevels(Side::kSell, 10);
-    for (auto it = asks.rbegin(); it != asks.rend(); ++it) {
+    // Both ladders formatted in one pass each, without allocating
+    std::array<PriceLevel, 10> levels;
+    std::array<LevelText, 10> text;
+    auto format_side = [&](Side side) {
+        size_t count = 0;
+        snapshot.ForEachLevel(side, levels.size(), [&](Price price, Quantity quantity) {
+            levels[count++] = PriceLevel(price, quantity);
+        });
+        return FormatLevels(std::span(levels.data(), count),
+                            book.GetPriceDecimals(), book.GetQuantityDecimals(), text);
+    };
+    
+    for (size_t i = format_side(Side::kSell); i-- > 0;) {
         std::cout << "  ASK  " 
-                  << std::setw(14) << SymbolConfig::FixedToString(it->price, 2)
+                  << std::setw(14) << text[i].price.View()
                   << "  |  " 
-                  << std::setw(14) << SymbolConfig::FixedToString(it->quantity, 8) 
+                  << std::setw(14) << text[i].quantity.View() 
                   << "\n";
     }
     
     std::cout << std::string(60, '=') << "\n";
     
-    auto bids = book.GetTopLevels(Side::kBuy, 10);
-    for (const auto& level : bids) {
+    size_t bid_count = format_side(Side::kBuy);
+    for (size_t i = 0; i < bid_count; ++i) {
         std::cout << "  BID  " 
-                  << std::setw(14) << SymbolConfig::FixedToString(level.price, 2)
+                  << std::setw(14) << text[i].price.View()
                   << "  |  " 
-                  << std::setw(14) << SymbolConfig::FixedToString(level.quantity, 8) 
+                  << std::setw(14) << text[i].quantity.View() 
                   << "\n";
     }
     
     std::cout << std::string(60, '-') << "\n";
     
     // Market data
-    auto spread = book.GetSpread();
-    auto mid = book.GetMidPrice();
-    
-    if (spread) {
-        std::cout << "Spread: " << SymbolConfig::FixedToString(*spread, 2) << " USDT";
-    }
-    if (mid) {
-        std::cout << "  |  Mid: " << SymbolConfig::FixedToString(*mid, 2) << " USDT";
+    auto best_bid = snapshot.GetBestBid();
+    auto best_ask = snapshot.GetBestAsk();
+    if (best_bid && best_ask) {
+        std::cout << "Spread: " << SymbolConfig::FixedToString(*best_ask - *best_bid, 2) << " USDT"
+                  << "  |  Mid: " << SymbolConfig::FixedToString((*best_bid + *best_ask) / 2, 2)
+                  << " USDT";
     }
     std::cout << "\n";
     
-    std::cout << "Updates: " << book.GetUpdateCount() 
-              << " | Levels: " << book.GetLevelCount(Side::kBuy) << "B / "
-              << book.GetLevelCount(Side::kSell) << "A\n";
+    std::cout << "Updates: " << snapshot.update_count 
+              << " | Levels: " << snapshot.GetLevelCount(Side::kBuy) << "B / "
+              << snapshot.GetLevelCount(Side::kSell) << "A\n";
+    
+    if (tape.trades > 0) {
+        std::cout << "Trades: " << tape.trades
+                  << " | Last: " << SymbolConfig::FixedToString(tape.last.price, 2)
+                  << " x " << SymbolConfig::FixedToString(tape.last.quantity, 8)
+                  << (tape.last.is_buyer_maker ? " [SELL]" : " [BUY]")
+                  << " | Taker buy/sell: " << SymbolConfig::FixedToString(tape.buy_volume, 8)
+                  << " / " << SymbolConfig::FixedToString(tape.sell_volume, 8) << "\n";
+    }
+    
+    // Other symbols on the combined stream: seqlock-published touch only
+    for (SymbolId id = 0; id < books.SymbolCount(); ++id) {
+        if (&books.Book(id) == &book) continue;
+        TopOfBook top = books.Book(id).GetTopOfBook();
+        int decimals = books.Book(id).GetPriceDecimals();
+        std::cout << "  " << std::left << std::setw(10) << books.Symbol(id) << std::right
+                  << " bid " << SymbolConfig::FixedToString(top.bid_price, decimals)
+                  << " | ask " << SymbolConfig::FixedToString(top.ask_price, decimals)
+                  << "\n";
+    }
     
     // Strategy indicators
     std::cout << std::string(60, '-') << "\n";
@@ -85,15 +185,15 @@ void PrintOrderBook(const OrderBook& book,
     std::cout << std::fixed << std::setprecision(4);
     
     // Spread monitor
-    std::cout << "  Spread: " << spread_strategy.GetCurrentSpreadPct() << "% "
-              << "(avg: " << spread_strategy.GetAverageSpreadPct() << "%)";
-    if (spread_strategy.IsAlertActive()) {
+    std::cout << "  Spread: " << event.spread_pct << "% "
+              << "(avg: " << event.average_spread_pct << "%)";
+    if (event.spread_alert) {
         std::cout << " [!!! WIDE !!!]";
     }
     std::cout << "\n";
     
     // Imbalance
-    double imbalance = imbalance_strategy.GetCurrentImbalance();
+    double imbalance = event.imbalance;
     std::cout << "  Imbalance: " << std::setprecision(1) << (imbalance * 100) << "% ";
     if (imbalance > 0.1) {
         std::cout << "[BUY PRESSURE ↑]";
@@ -140,25 +240,68 @@ void PrintOrderBook(const OrderBook& book,
 }
 
 int main(int argc, char* argv[]) {
-    std::string symbol = "btcusdt";
-    if (argc > 1) {
-        symbol = argv[1];
+    // Strategies run on the first symbol; the rest are only tracked.
+    // --legs=N reads the streams over N redundant connections;
+    // --busy-poll, --cpu=N, --rt=P and --busy-poll-usec=U tune the I/O thread;
+    // --wait=spin|yield|block picks how the pipeline stages wait, and
+    // --record=FILE adds a stage that logs every event.
+    std::vector<std::string> symbols;
+    size_t feed_legs = 1;
+    IoConfig io_config;
+    StageConfig stage_config;
+    std::string record_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.starts_with("--legs=")) {
+            feed_legs = std::stoul(arg.substr(7));
+        } else if (arg == "--busy-poll") {
+            io_config.mode = IoMode::kBusyPoll;
+        } else if (arg.starts_with("--cpu=")) {
+            io_config.cpu = std::stoi(arg.substr(6));
+        } else if (arg.starts_with("--rt=")) {
+            io_config.realtime_priority = std::stoi(arg.substr(5));
+        } else if (arg.starts_with("--busy-poll-usec=")) {
+            io_config.busy_poll_usec = std::stoi(arg.substr(17));
+        } else if (arg == "--wait=spin") {
+            stage_config.wait = WaitStrategy::kBusySpin;
+        } else if (arg == "--wait=yield") {
+            stage_config.wait = WaitStrategy::kYield;
+        } else if (arg == "--wait=block") {
+            stage_config.wait = WaitStrategy::kBlock;
+        } else if (arg.starts_with("--record=")) {
+            record_path = arg.substr(9);
+        } else {
+            symbols.push_back(arg);
+        }
+    }
+    if (symbols.empty()) {
+        symbols.push_back("btcusdt");
     }
     
-    std::cout << "Starting Binance stream with strategies for " << symbol << "...\n";
+    std::cout << "Starting Binance stream with strategies for " << symbols.front() << "...\n";
     
     std::signal(SIGINT, SignalHandler);
     std::signal(SIGTERM, SignalHandler);
     
     // Create components
-    OrderBook book(symbol, 2, 8);
-    LatencyStats latency_stats("Processing");
+    BookManager books;
+    for (const auto& symbol : symbols) {
+        books.AddSymbol(symbol, 2, 8);
+    }
+    const SymbolId symbol_id = 0;  // First symbol drives the strategies
+    OrderBook& book = books.Book(symbol_id);
+    // Written only by the book stage; the display reads it without locking
+    LatencyHistogram latency_stats("Processing");
+    TradeTape trade_tape;
     SignalLog signal_log;
     
     // Create strategies
     SpreadMonitorStrategy spread_strategy(0.5);  // Alert if spread > 50% above average
     ImbalanceStrategy imbalance_strategy(0.3, 10);  // Alert if imbalance > 30%
     
+    // Imbalance inputs maintained incrementally by the book
+    book.TrackDepth(imbalance_strategy.GetDepth());
+    
     // Set up signal callbacks
     spread_strategy.SetOnSignal([&](const Signal& sig) {
         signal_log.Add(spread_strategy.GetName(), sig);
@@ -168,70 +311,186 @@ int main(int argc, char* argv[]) {
         signal_log.Add(imbalance_strategy.GetName(), sig);
     });
     
-    // Track synchronization
-    int64_t last_update_id = 0;
-    std::atomic<bool> synchronized{false};
     std::atomic<bool> connected{false};
     
-    // Create client
+    // Create client: one combined stream for every symbol
     auto client = std::make_shared<BinanceClient>();
-    client->SetSymbol(symbol);
+    
+    // The I/O thread only parses and publishes into this ring; the book,
+    // display and recorder stages consume it on their own threads
+    RingBuffer<PipelineEvent> ring(kRingCapacity);
+    auto publish = [&ring](auto&& fill) {
+        int64_t sequence = ring.Next();
+        fill(ring[sequence].feed, NowNanos());
+        ring.Publish(sequence);
+    };
+    
+    // Snapshot sync per symbol, indexed by SymbolId; fetches run on worker
+    // threads, completion is handed to the book stage through the ring
+    std::vector<std::unique_ptr<BookSynchronizer>> sync;
+    for (SymbolId id = 0; id < books.SymbolCount(); ++id) {
+        std::string symbol = books.Symbol(id);
+        auto synchronizer = std::make_unique<BookSynchronizer>(
+            books, id, [symbol](const std::atomic<bool>& cancel) {
+                return BinanceClient::FetchDepthSnapshotBody(
+                    symbol, BinanceClient::kMaxSnapshotLimit, BinanceClient::kSnapshotTimeout, &cancel);
+            });
+        synchronizer->SetOnReady([&client, &publish, id]() {
+            client->Post([&publish, id]() {
+                publish([id](FeedEvent& event, Timestamp now) { event.AssignSnapshotReady(id, now); });
+            });
+        });
+        sync.push_back(std::move(synchronizer));
+    }
+    client->SetSymbol(books.Symbol(symbol_id), symbol_id);
+    client->SetPrecision(book.GetPriceDecimals(), book.GetQuantityDecimals());
+    for (SymbolId id = 1; id < books.SymbolCount(); ++id) {
+        const OrderBook& b = books.Book(id);
+        client->AddSymbol(books.Symbol(id), id, b.GetPriceDecimals(), b.GetQuantityDecimals());
+    }
+    client->SubscribeAggTrades();
+    client->SubscribeBookTicker();
+    client->SetFeedLegs(feed_legs);
+    client->SetIoConfig(io_config);
     
     client->SetOnConnected([&]() {
         std::cout << "Connected to Binance WebSocket\n";
         connected = true;
     });
     
-    client->SetOnDepthUpdate([&](const DepthUpdate& update) {
-        if (!synchronized) {
-            std::cout << "First update received, fetching snapshot...\n";
-            try {
-                auto snapshot = client->FetchDepthSnapshot(1000);
-                last_update_id = snapshot.last_update_id;
-                
-                book.Clear();
-                for (const auto& [price, qty] : snapshot.bids) {
-                    book.UpdateFromStrings(Side::kBuy, price, qty);
-                }
-                for (const auto& [price, qty] : snapshot.asks) {
-                    book.UpdateFromStrings(Side::kSell, price, qty);
-                }
-                
-                synchronized = true;
-                std::cout << "Synchronized! Starting strategies...\n\n";
-            } catch (const std::exception& e) {
-                std::cerr << "Failed to fetch snapshot: " << e.what() << "\n";
+    client->SetOnDepthDeltas([&](const DepthDeltas& update) {
+        publish([&](FeedEvent& event, Timestamp now) { event.AssignDepth(update, now); });
+    });
+    
+    client->SetOnBookTicker([&](const BookTicker& ticker) {
+        publish([&](FeedEvent& event, Timestamp now) { event.AssignTicker(ticker, now); });
+    });
+    
+    client->SetOnTrade([&](const TradeEvent& trade) {
+        if (trade.symbol_id == symbol_id) {
+            publish([&](FeedEvent& event, Timestamp now) { event.AssignTrade(trade, now); });
+        }
+    });
+    
+    // Display reads published snapshots, never the live ladders
+    book.EnableSnapshots();
+    
+    // Book stage: sole writer of every book; strategies run here too since
+    // they read the live book
+    uint64_t messages_applied = 0;
+    auto apply_depth = [&](const FeedEvent& feed) {
+        BookSynchronizer& state = *sync[feed.symbol_id];
+        DepthDeltas update = feed.Depth();
+        if (!state.IsLive()) {
+            // Buffered until the snapshot is in; the fetch runs elsewhere
+            if (state.GetState() == BookSynchronizer::State::kIdle) {
+                std::cout << "First " << books.Symbol(feed.symbol_id)
+                          << " update received, fetching snapshot...\n";
             }
-            return;
+            if (state.OnDiff(update) && state.IsLive()) {
+                std::cout << "Synchronized " << books.Symbol(feed.symbol_id) << "!\n\n";
+            }
+            return false;
         }
         
-        if (update.final_update_id <= last_update_id) return;
-        
-        // Measure latency
-        auto start_time = NowNanos();
-        
-        // Update order book
-        for (const auto& [price, qty] : update.bids) {
-            book.UpdateFromStrings(Side::kBuy, price, qty);
+        // Update order book; levels arrive already in fixed point
+        if (!state.OnDiff(update)) {
+            if (state.IsStale()) {
+                std::cerr << "Sequence gap in " << books.Symbol(feed.symbol_id)
+                          << " (expected U=" << state.GetLastUpdateId() + 1
+                          << ", got " << feed.first_update_id << "), resynchronizing...\n";
+            }
+            return false;
         }
-        for (const auto& [price, qty] : update.asks) {
-            book.UpdateFromStrings(Side::kSell, price, qty);
+        return true;
+    };
+    
+    EventProcessor<PipelineEvent> book_stage(ring, [&](PipelineEvent& event, int64_t, bool) {
+        const FeedEvent& feed = event.feed;
+        event.refresh_display = false;
+        bool changed = false;
+        
+        switch (feed.kind) {
+            case FeedEvent::Kind::kDepth:
+                changed = apply_depth(feed);
+                break;
+                
+            case FeedEvent::Kind::kBookTicker: {
+                // Touch changes between depth batches; the diff stream keeps the rest
+                if (!sync[feed.symbol_id]->IsLive()) break;
+                const BookTicker& ticker = feed.ticker;
+                TopOfBook quote{ticker.bid_price, ticker.bid_quantity,
+                                ticker.ask_price, ticker.ask_quantity, ticker.update_id, 0};
+                changed = books.ApplyTicker(feed.symbol_id, quote);
+                break;
+            }
+                
+            case FeedEvent::Kind::kSnapshotReady: {
+                BookSynchronizer& state = *sync[feed.symbol_id];
+                uint64_t failures = state.GetFetchFailureCount();
+                if (state.Poll()) {
+                    std::cout << "Synchronized " << books.Symbol(feed.symbol_id) << "!\n\n";
+                } else if (state.GetFetchFailureCount() != failures) {
+                    std::cerr << "Failed to fetch snapshot: " << state.GetLastError() << "\n";
+                }
+                break;
+            }
+                
+            case FeedEvent::Kind::kTrade:
+                break;
         }
         
+        if (!changed || feed.symbol_id != symbol_id) return;
+        
         // Run strategies
         spread_strategy.OnOrderBookUpdate(book);
         imbalance_strategy.OnOrderBookUpdate(book);
+        event.spread_pct = spread_strategy.GetCurrentSpreadPct();
+        event.average_spread_pct = spread_strategy.GetAverageSpreadPct();
+        event.spread_alert = spread_strategy.IsAlertActive();
+        event.imbalance = imbalance_strategy.GetCurrentImbalance();
         
-        auto end_time = NowNanos();
-        latency_stats.Record(end_time - start_time);
+        if (feed.kind != FeedEvent::Kind::kDepth) return;
         
-        last_update_id = update.final_update_id;
+        // Receive to strategies done, including time queued in the ring
+        latency_stats.Record(NowNanos() - feed.received);
         
-        // Print every 50 updates
-        if (book.GetUpdateCount() % 50 == 0) {
-            PrintOrderBook(book, latency_stats, spread_strategy, imbalance_strategy, signal_log);
+        // Print every 50 messages
+        if (++messages_applied % 50 == 0) {
+            book.PublishSnapshot();
+            event.refresh_display = true;
         }
-    });
+    }, stage_config);
+    
+    // Display stage: after the book stage, so it sees what that wrote
+    EventProcessor<PipelineEvent> display_stage(ring, [&](PipelineEvent& event, int64_t, bool) {
+        if (event.feed.kind == FeedEvent::Kind::kTrade) {
+            trade_tape.Add(event.feed.trade);
+        }
+        if (!event.refresh_display) return;
+        if (auto snapshot = book.GetSnapshot()) {
+            PrintOrderBook(*snapshot, book, books, trade_tape, latency_stats, event, signal_log);
+        }
+    }, stage_config);
+    display_stage.After(book_stage);
+    ring.AddGatingSequence(display_stage.GetSequence());
+    
+    // Recorder stage: parallel to the others, raw events only
+    std::ofstream record_file;
+    std::unique_ptr<EventProcessor<PipelineEvent>> recorder_stage;
+    if (!record_path.empty()) {
+        record_file.open(record_path);
+        recorder_stage = std::make_unique<EventProcessor<PipelineEvent>>(
+            ring, [&](PipelineEvent& event, int64_t, bool end_of_batch) {
+                RecordEvent(record_file, event.feed, books);
+                if (end_of_batch) record_file.flush();
+            }, stage_config);
+        ring.AddGatingSequence(recorder_stage->GetSequence());
+    }
+    
+    book_stage.Start();
+    display_stage.Start();
+    if (recorder_stage) recorder_stage->Start();
     
     client->SetOnError([](const std::string& error) {
         std::cerr << "Error: " << error << "\n";
@@ -263,8 +522,11 @@ int main(int argc, char* argv[]) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
-    // Cleanup
+    // Cleanup: stop the producer, then the stages
     client->Disconnect();
+    book_stage.Halt();
+    display_stage.Halt();
+    if (recorder_stage) recorder_stage->Halt();
     
     // Print final statistics
     std::cout << "\n" << std::string(60, '=') << "\n";
@@ -274,7 +536,42 @@ int main(int argc, char* argv[]) {
     std::cout << "Connection:\n";
     std::cout << "  Messages received: " << client->GetMessagesReceived() << "\n";
     std::cout << "  Bytes received: " << client->GetBytesReceived() << "\n";
-    std::cout << "  Order book updates: " << book.GetUpdateCount() << "\n\n";
+    std::cout << "  Order book updates: " << book.GetUpdateCount() << "\n";
+    std::cout << "  Ring stalls (I/O thread waited for a stage): " << ring.GetStallCount() << "\n\n";
+    
+    if (client->GetFeedLegCount() > 1) {
+        const FeedArbiter& arbiter = client->GetArbiter();
+        std::cout << "Feed legs:\n";
+        for (size_t leg = 0; leg < arbiter.GetLegCount(); ++leg) {
+            const auto& stats = arbiter.GetLegStats(leg);
+            auto lag = stats.lag.Calculate();
+            std::cout << std::fixed << std::setprecision(1)
+                      << "  Leg " << leg << ": " << stats.messages << " messages"
+                      << " | win rate " << stats.WinRate() * 100 << "%"
+                      << " | lag when second: mean " << lag.mean_ns / 1000.0 << "μs"
+                      << ", P99 " << lag.p99_ns / 1000.0 << "μs\n";
+        }
+        std::cout << "\n";
+    }
+    
+    std::cout << "Snapshot sync:\n";
+    for (const auto& state : sync) {
+        std::cout << "  " << books.Symbol(state->GetSymbolId())
+                  << ": snapshots " << state->GetSnapshotCount()
+                  << " | replayed " << state->GetReplayedCount()
+                  << " | stale " << state->GetStaleDroppedCount()
+                  << " | fetch failures " << state->GetFetchFailureCount()
+                  << " | refetches " << state->GetRefetchCount()
+                  << " | gaps " << state->GetGapCount()
+                  << " (" << state->GetMissedUpdateCount() << " updates missed)\n";
+        if (state->GetResyncStats().Count() > 0) {
+            auto resync = state->GetResyncStats().Calculate();
+            std::cout << std::fixed << std::setprecision(1)
+                      << "    resync: mean " << resync.mean_ns / 1e6 << " ms"
+                      << " | max " << resync.max_ns / 1e6 << " ms\n";
+        }
+    }
+    std::cout << "\n";
     
     std::cout << latency_stats.ToString() << "\n";
     
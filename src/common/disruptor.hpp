@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "thread_tuning.hpp"
+
+namespace hft {
+
+/**
+ * How a consumer waits for its next sequence.
+ */
+enum class WaitStrategy : uint8_t {
+    kBusySpin,  // Poll continuously: lowest latency, burns a core
+    kYield,     // Poll, yielding the core between checks
+    kBlock      // Sleep on a condition variable until signalled
+};
+
+/**
+ * Published position of the producer or of one consumer. Starts at -1
+ * (nothing published/consumed) and sits on its own cache line so stages
+ * polling it do not false-share.
+ */
+struct alignas(64) Sequence {
+    std::atomic<int64_t> value{-1};
+
+    int64_t Get() const { return value.load(std::memory_order_acquire); }
+    void Set(int64_t sequence) { value.store(sequence, std::memory_order_release); }
+};
+
+/**
+ * Wake-up channel for kBlock consumers of one ring. Notify() is a fence
+ * and a load unless somebody is actually asleep.
+ */
+class WaitSignal {
+public:
+    template <typename Ready>
+    void Wait(Ready&& ready) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        cv_.wait(lock, ready);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Call after advancing a sequence
+    void Notify() {
+        // Pairs with the waiter's increment: either we see it, or it sees our store
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+        NotifyAll();
+    }
+
+    void NotifyAll() {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<int> waiters_{0};
+};
+
+/**
+ * Pre-allocated single-producer ring of events (Disruptor pattern).
+ *
+ * The producer claims a sequence with Next(), fills the slot in place and
+ * Publish()es it; consumers (EventProcessor) read slots up to the cursor
+ * and never copy them out. Slots are reused, so an event type holding
+ * vectors keeps their capacity and steady-state publishing does not
+ * allocate. The producer waits (yielding) while the slowest gating
+ * consumer is a full lap behind.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity)
+        : entries_(std::bit_ceil(std::max<size_t>(capacity, 1)))
+        , mask_(static_cast<int64_t>(entries_.size()) - 1) {}
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // === Producer (one thread) ===
+
+    /**
+     * Claim the next slot; returns its sequence.
+     */
+    int64_t Next() {
+        int64_t sequence = ++claimed_;
+        int64_t wrap_point = sequence - static_cast<int64_t>(entries_.size());
+        if (wrap_point > cached_gating_) {
+            cached_gating_ = MinimumGating(sequence - 1);
+            if (wrap_point > cached_gating_) {
+                ++stalls_;
+                do {
+                    std::this_thread::yield();
+                    cached_gating_ = MinimumGating(sequence - 1);
+                } while (wrap_point > cached_gating_);
+            }
+        }
+        return sequence;
+    }
+
+    void Publish(int64_t sequence) {
+        cursor_.Set(sequence);
+        signal_.Notify();
+    }
+
+    /**
+     * Consumers the producer must not lap. Add the last stage of every
+     * branch before publishing.
+     */
+    void AddGatingSequence(const Sequence& sequence) { gating_.push_back(&sequence); }
+
+    // === Shared ===
+
+    T& operator[](int64_t sequence) { return entries_[static_cast<size_t>(sequence & mask_)]; }
+    const T& operator[](int64_t sequence) const {
+        return entries_[static_cast<size_t>(sequence & mask_)];
+    }
+
+    const Sequence& GetCursor() const { return cursor_; }
+    WaitSignal& GetSignal() { return signal_; }
+    size_t GetCapacity() const { return entries_.size(); }
+
+    // Claims that had to wait for a consumer (producer thread)
+    uint64_t GetStallCount() const { return stalls_; }
+
+private:
+    int64_t MinimumGating(int64_t minimum) const {
+        for (const Sequence* sequence : gating_) {
+            minimum = std::min(minimum, sequence->Get());
+        }
+        return minimum;
+    }
+
+    std::vector<T> entries_;
+    int64_t mask_;
+    Sequence cursor_;
+    WaitSignal signal_;
+    std::vector<const Sequence*> gating_;
+
+    // Producer-only state
+    int64_t claimed_ = -1;
+    int64_t cached_gating_ = -1;
+    uint64_t stalls_ = 0;
+};
+
+/**
+ * Per-stage thread settings.
+ */
+struct StageConfig {
+    WaitStrategy wait = WaitStrategy::kBlock;
+    int cpu = -1;  // Pin the stage thread to this core (-1: no pinning)
+};
+
+/**
+ * One consumer stage: a thread that hands every published event, in
+ * order, to its handler, then advances its own sequence.
+ *
+ * A stage trails the producer, and any upstream stages named with
+ * After(): it only sees an event once they are done with it, so it may
+ * read what they wrote into the slot. Stages that do not depend on each
+ * other run in parallel on the same events. The handler gets
+ * end_of_batch = true on the last event currently available, e.g. to
+ * flush.
+ */
+template <typename T>
+class EventProcessor {
+public:
+    using Handler = std::function<void(T& event, int64_t sequence, bool end_of_batch)>;
+
+    EventProcessor(RingBuffer<T>& ring, Handler handler, StageConfig config = StageConfig())
+        : ring_(ring), handler_(std::move(handler)), config_(config) {}
+
+    ~EventProcessor() { Halt(); }
+
+    EventProcessor(const EventProcessor&) = delete;
+    EventProcessor& operator=(const EventProcessor&) = delete;
+
+    // Before Start()
+    void After(const EventProcessor& upstream) { upstream_.push_back(&upstream.sequence_); }
+
+    void Start() {
+        halted_.store(false, std::memory_order_relaxed);
+        thread_ = std::thread([this]() { Run(); });
+    }
+
+    /**
+     * Stop after the current batch and join. Events not reached yet are
+     * left unprocessed.
+     */
+    void Halt() {
+        halted_.store(true, std::memory_order_seq_cst);
+        ring_.GetSignal().NotifyAll();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    const Sequence& GetSequence() const { return sequence_; }
+
+private:
+    void Run() {
+        if (config_.cpu >= 0) {
+            PinCurrentThread(config_.cpu);
+        }
+
+        int64_t next = sequence_.Get() + 1;
+        for (;;) {
+            int64_t available = WaitFor(next);
+            if (available < next) return;  // Halted
+
+            for (; next <= available; ++next) {
+                handler_(ring_[next], next, next == available);
+            }
+            sequence_.Set(available);
+            ring_.GetSignal().Notify();  // Downstream stages may be asleep
+        }
+    }
+
+    // Highest sequence every dependency has passed
+    int64_t Available() const {
+        int64_t available = ring_.GetCursor().Get();
+        for (const Sequence* upstream : upstream_) {
+            available = std::min(available, upstream->Get());
+        }
+        return available;
+    }
+
+    bool Halted() const { return halted_.load(std::memory_order_acquire); }
+
+    int64_t WaitFor(int64_t sequence) {
+        int64_t available = Available();
+        switch (config_.wait) {
+            case WaitStrategy::kBusySpin:
+                while (available < sequence && !Halted()) {
+#if defined(__x86_64__) || defined(__i386__)
+                    __builtin_ia32_pause();
+#endif
+                    available = Available();
+                }
+                break;
+
+            case WaitStrategy::kYield:
+                while (available < sequence && !Halted()) {
+                    std::this_thread::yield();
+                    available = Available();
+                }
+                break;
+
+            case WaitStrategy::kBlock:
+                if (available < sequence) {
+                    ring_.GetSignal().Wait([&]() {
+                        available = Available();
+                        return available >= sequence || Halted();
+                    });
+                }
+                break;
+        }
+        return available;
+    }
+
+    RingBuffer<T>& ring_;
+    Handler handler_;
+    StageConfig config_;
+    std::vector<const Sequence*> upstream_;
+    Sequence sequence_;
+    std::atomic<bool> halted_{false};
+    std::thread thread_;
+};
+
+}  // namespace hft
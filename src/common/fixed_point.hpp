@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace hft {
+
+// Powers of ten representable in int64_t
+inline constexpr int64_t kPow10[19] = {
+    1LL,
+    10LL,
+    100LL,
+    1000LL,
+    10000LL,
+    100000LL,
+    1000000LL,
+    10000000LL,
+    100000000LL,
+    1000000000LL,
+    10000000000LL,
+    100000000000LL,
+    1000000000000LL,
+    10000000000000LL,
+    100000000000000LL,
+    1000000000000000LL,
+    10000000000000000LL,
+    100000000000000000LL,
+    1000000000000000000LL,
+};
+
+// === Validating Decimal Parser ===
+// Binance sends fixed-width decimals such as "30000.50000000". Runs of
+// eight digits are converted with SWAR arithmetic on one 64-bit load;
+// shorter runs fall back to a scalar loop.
+
+/**
+ * True if all eight bytes of a little-endian word are ASCII digits.
+ */
+inline bool IsEightDigits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+/**
+ * Value of eight ASCII digits loaded little-endian ("12345678" -> 12345678).
+ */
+inline uint64_t EightDigitsValue(uint64_t word) {
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);  // Pairs of digits
+    return (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+}
+
+/**
+ * Value of 1..8 digits at p, with eight bytes readable from p. The word
+ * is shifted so the digits are right-aligned and the vacated bytes are
+ * filled with '0'.
+ */
+inline bool ReadEightOrFewer(const char* p, size_t count, uint64_t& value) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    if (count < 8) {
+        word = (word << (8 * (8 - count))) | (0x3030303030303030ULL >> (8 * count));
+    }
+    if (!IsEightDigits(word)) return false;
+    value = EightDigitsValue(word);
+    return true;
+}
+
+/**
+ * Value of `count` (<= 18) digits at p; `end` bounds what may be loaded.
+ * Eight-digit chunks go through ReadEightOrFewer while eight bytes are
+ * readable, the rest one digit at a time.
+ */
+inline bool ReadDigits(const char* p, size_t count, const char* end, uint64_t& value) {
+    value = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        while (count > 0 && end - p >= 8) {
+            size_t n = count < 8 ? count : 8;
+            uint64_t chunk;
+            if (!ReadEightOrFewer(p, n, chunk)) return false;
+            value = value * static_cast<uint64_t>(kPow10[n]) + chunk;
+            p += n;
+            count -= n;
+        }
+    }
+    for (; count > 0; ++p, --count) {
+        uint64_t digit = static_cast<uint64_t>(static_cast<unsigned char>(*p) - '0');
+        if (digit > 9) return false;
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+/**
+ * First '.' in [p, end), or end. The first eight bytes are searched with
+ * one load using the has-zero-byte trick on word ^ "........".
+ */
+inline const char* FindDot(const char* p, const char* end) {
+    if constexpr (std::endian::native == std::endian::little) {
+        if (end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            uint64_t x = word ^ 0x2E2E2E2E2E2E2E2EULL;
+            uint64_t found = (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+            if (found != 0) return p + (std::countr_zero(found) >> 3);
+            p += 8;
+        }
+    }
+    while (p != end && *p != '.') ++p;
+    return p;
+}
+
+/**
+ * Overflow-checked digit accumulation for numbers longer than 18 digits.
+ */
+inline bool AccumulateDigitsChecked(const char* p, size_t count, int64_t& value) {
+    for (; count > 0; ++p, --count) {
+        int64_t digit = static_cast<unsigned char>(*p) - '0';
+        if (digit < 0 || digit > 9) return false;
+        if (__builtin_mul_overflow(value, 10, &value) ||
+            __builtin_add_overflow(value, digit, &value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Strict decimal string to fixed point: [-]digits[.digits].
+ * Digits beyond `decimals` must be zeros, otherwise the value is not
+ * representable and parsing fails. Returns false on empty input, any
+ * other character, int64_t overflow, or `decimals` outside [0, 18];
+ * `out` is untouched on failure.
+ */
+inline bool ParseFixed(std::string_view s, int decimals, int64_t& out) {
+    if (decimals < 0 || decimals > 18) return false;
+
+    const char* p = s.data();
+    const char* end = p + s.size();
+
+    bool negative = (p != end && *p == '-');
+    if (negative) ++p;
+
+    const char* int_end = FindDot(p, end);
+    const char* frac = (int_end != end) ? int_end + 1 : end;
+
+    size_t int_digits = static_cast<size_t>(int_end - p);
+    size_t frac_digits = static_cast<size_t>(end - frac);
+    if (int_digits + frac_digits == 0) return false;
+
+    size_t scale = static_cast<size_t>(decimals);
+    size_t kept = frac_digits < scale ? frac_digits : scale;
+
+    // Excess decimals must be zero
+    for (const char* q = frac + kept; q != end; ++q) {
+        if (*q != '0') return false;
+    }
+
+    int64_t value;
+    if (std::endian::native == std::endian::little &&
+        int_digits <= 8 && kept <= 8 && int_digits + scale <= 18 &&
+        end - p >= 8 && end - frac >= 8) {
+        // Binance shape ("30000.50000000"): one load per part; at most 18
+        // significant digits, so no overflow
+        uint64_t integer = 0;
+        uint64_t fraction = 0;
+        if (int_digits != 0 && !ReadEightOrFewer(p, int_digits, integer)) return false;
+        if (kept != 0 && !ReadEightOrFewer(frac, kept, fraction)) return false;
+        value = static_cast<int64_t>((integer * static_cast<uint64_t>(kPow10[kept]) + fraction) *
+                                     static_cast<uint64_t>(kPow10[scale - kept]));
+    } else if (int_digits + scale <= 18) {
+        // At most 18 significant digits: cannot overflow, no checks
+        uint64_t integer;
+        uint64_t fraction;
+        if (!ReadDigits(p, int_digits, end, integer) ||
+            !ReadDigits(frac, kept, end, fraction)) {
+            return false;
+        }
+        value = static_cast<int64_t>((integer * static_cast<uint64_t>(kPow10[kept]) + fraction) *
+                                     static_cast<uint64_t>(kPow10[scale - kept]));
+    } else {
+        value = 0;
+        if (!AccumulateDigitsChecked(p, int_digits, value) ||
+            !AccumulateDigitsChecked(frac, kept, value) ||
+            __builtin_mul_overflow(value, kPow10[scale - kept], &value)) {
+            return false;
+        }
+    }
+
+    out = negative ? -value : value;
+    return true;
+}
+
+// === Allocation-Free Formatter ===
+// The integer part goes through std::to_chars; the fraction, which needs
+// leading zeros, is written two digits at a time from a pair table.
+
+// "00" "01" ... "99"
+inline constexpr auto kDigitPairs = [] {
+    std::array<char, 200> pairs{};
+    for (int i = 0; i < 100; ++i) {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+// Upper bound on FormatFixed output: sign, integer digits, point and up
+// to 18 decimals
+inline constexpr size_t kMaxFixedChars = 40;
+
+/**
+ * Write exactly `count` digits of value (value < 10^count), zero-padded.
+ */
+inline void WriteDigitsPadded(char* out, uint64_t value, int count) {
+    char* p = out + count;
+    for (; count >= 2; count -= 2) {
+        p -= 2;
+        std::memcpy(p, &kDigitPairs[(value % 100) * 2], 2);
+        value /= 100;
+    }
+    if (count != 0) *--p = static_cast<char>('0' + value);
+}
+
+/**
+ * Format a fixed-point value into `out`, which must have room for
+ * kMaxFixedChars. Returns one past the last character written; nothing
+ * is NUL-terminated. 3000050 with decimals=2 -> "30000.50"; the point is
+ * always written, so decimals=0 gives "123.". `decimals` is clamped to
+ * [0, 18], the range ParseFixed accepts.
+ */
+inline char* FormatFixed(char* out, int64_t value, int decimals) {
+    decimals = decimals < 0 ? 0 : (decimals > 18 ? 18 : decimals);
+
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                   : static_cast<uint64_t>(value);
+    if (value < 0) *out++ = '-';
+
+    uint64_t scale = static_cast<uint64_t>(kPow10[decimals]);
+    out = std::to_chars(out, out + 20, magnitude / scale).ptr;
+    *out++ = '.';
+    WriteDigitsPadded(out, magnitude % scale, decimals);
+    return out + decimals;
+}
+
+/**
+ * Formatted number held inline, for callers without a buffer at hand.
+ */
+struct FixedText {
+    std::array<char, kMaxFixedChars> chars;
+    uint8_t size = 0;
+
+    std::string_view View() const { return std::string_view(chars.data(), size); }
+};
+
+inline FixedText FormatFixed(int64_t value, int decimals) {
+    FixedText text;
+    text.size = static_cast<uint8_t>(FormatFixed(text.chars.data(), value, decimals) -
+                                     text.chars.data());
+    return text;
+}
+
+/**
+ * Decimal string to fixed-point conversion with the number of decimals
+ * known at compile time: the scale is a constant and the fractional loop
+ * has a constant trip count, so the compiler can unroll it.
+ *
+ * Parse() has the same rules as SymbolConfig::StringToFixed: non-digits
+ * other than the dot are skipped and decimals beyond `Decimals` are
+ * truncated. TryParse() is the strict form (see ParseFixed).
+ */
+template <int Decimals>
+struct FixedPoint {
+    static_assert(Decimals >= 0 && Decimals <= 18, "Decimals must fit int64_t");
+
+    static constexpr int kDecimals = Decimals;
+    static constexpr int64_t kScale = kPow10[Decimals];
+
+    static bool TryParse(std::string_view s, int64_t& out) {
+        return ParseFixed(s, Decimals, out);
+    }
+
+    // "30000.50" -> 3000050 for Decimals = 2
+    static constexpr int64_t Parse(std::string_view s) {
+        if (!std::is_constant_evaluated()) {
+            int64_t value;
+            if (ParseFixed(s, Decimals, value)) return value;
+        }
+
+        int64_t result = 0;
+        size_t i = 0;
+        for (; i < s.size() && s[i] != '.'; ++i) {
+            if (IsDigit(s[i])) result = result * 10 + (s[i] - '0');
+        }
+
+        int fraction = 0;
+        for (++i; i < s.size() && fraction < Decimals; ++i) {
+            if (IsDigit(s[i])) {
+                result = result * 10 + (s[i] - '0');
+                ++fraction;
+            }
+        }
+        return result * kPow10[Decimals - fraction];
+    }
+
+private:
+    static constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+};
+
+}  // namespace hft
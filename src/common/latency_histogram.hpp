@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include "latency_stats.hpp"
+
+namespace hft {
+
+/**
+ * Fixed-size latency histogram for hot paths.
+ *
+ * Record() is a handful of relaxed stores into a preallocated bucket
+ * array: no lock, no allocation, constant memory however long the
+ * session runs. Values below 64 ns get exact buckets; above that each
+ * power of two is split into 32 buckets, so a percentile is within ~3%
+ * of the true sample. Values are clamped at 2^36 ns (~69 s); min, max
+ * and mean stay exact.
+ *
+ * One writer thread calls Record(); any thread may call Calculate(),
+ * which walks the buckets and may see a sample half-recorded.
+ */
+class LatencyHistogram {
+public:
+    explicit LatencyHistogram(const std::string& name) : name_(name) {}
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Writer thread only
+    void Record(int64_t latency_ns) {
+        uint64_t value = latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0;
+        Bump(counts_[BucketOf(std::min(value, kMaxValue))], 1);
+        Bump(count_, 1);
+        Bump(sum_, value);
+        if (value < min_.load(std::memory_order_relaxed)) {
+            min_.store(value, std::memory_order_relaxed);
+        }
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    size_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+    /**
+     * Percentiles from the buckets, each reported as its bucket's
+     * midpoint clamped to [min, max].
+     */
+    LatencyStats::Stats Calculate() const {
+        std::array<uint64_t, kBuckets> counts;
+        uint64_t n = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            counts[i] = counts_[i].load(std::memory_order_relaxed);
+            n += counts[i];
+        }
+        if (n == 0) {
+            return LatencyStats::Stats{0, 0, 0, 0, 0, 0, 0, 0, 0};
+        }
+
+        double min = static_cast<double>(min_.load(std::memory_order_relaxed));
+        double max = static_cast<double>(max_.load(std::memory_order_relaxed));
+        auto at_rank = [&](uint64_t rank) {
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBuckets; ++i) {
+                seen += counts[i];
+                if (seen > rank) {
+                    double mid = static_cast<double>(BucketLow(i)) +
+                                 static_cast<double>(BucketWidth(i) - 1) / 2;
+                    return std::clamp(mid, min, max);
+                }
+            }
+            return max;
+        };
+
+        return LatencyStats::Stats{
+            .count = static_cast<size_t>(n),
+            .min_ns = min,
+            .max_ns = max,
+            .mean_ns = static_cast<double>(sum_.load(std::memory_order_relaxed)) / n,
+            .median_ns = at_rank(n / 2),
+            .p50_ns = at_rank(n * 50 / 100),
+            .p90_ns = at_rank(n * 90 / 100),
+            .p99_ns = at_rank(n * 99 / 100),
+            .p999_ns = at_rank(n * 999 / 1000)
+        };
+    }
+
+    std::string ToString() const { return LatencyStats::Format(name_, Calculate()); }
+
+    const std::string& Name() const { return name_; }
+
+private:
+    static constexpr int kSubBits = 5;                      // 32 buckets per power of two
+    static constexpr uint64_t kLinear = uint64_t{2} << kSubBits;  // Exact below 64
+    static constexpr uint64_t kMaxValue = uint64_t{1} << 36;
+    static constexpr size_t kBuckets =
+        (std::bit_width(kMaxValue) - kSubBits - 1) * (size_t{1} << kSubBits) + kLinear;
+
+    static size_t BucketOf(uint64_t value) {
+        if (value < kLinear) return static_cast<size_t>(value);
+        int shift = std::bit_width(value) - kSubBits - 1;
+        return (static_cast<size_t>(shift) << kSubBits) + static_cast<size_t>(value >> shift);
+    }
+
+    static uint64_t BucketLow(size_t bucket) {
+        if (bucket < kLinear) return bucket;
+        int shift = static_cast<int>(bucket >> kSubBits) - 1;
+        return (bucket - (static_cast<size_t>(shift) << kSubBits)) << shift;
+    }
+
+    static uint64_t BucketWidth(size_t bucket) {
+        return bucket < kLinear ? 1 : uint64_t{1} << ((bucket >> kSubBits) - 1);
+    }
+
+    // Single writer: a plain load and store, no locked read-modify-write
+    static void Bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount,
+                      std::memory_order_relaxed);
+    }
+
+    std::string name_;
+    std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace hft
@@ -75,11 +75,12 @@ public:
     }
     
     // Format statistics as string
-    std::string ToString() const {
-        auto s = Calculate();
+    std::string ToString() const { return Format(name_, Calculate()); }
+    
+    static std::string Format(const std::string& name, const Stats& s) {
         std::ostringstream oss;
         oss << std::fixed << std::setprecision(0);
-        oss << name_ << " Latency Statistics:\n";
+        oss << name << " Latency Statistics:\n";
         oss << "  Count:  " << s.count << " samples\n";
         oss << "  Min:    " << s.min_ns << " ns\n";
         oss << "  Mean:   " << s.mean_ns << " ns\n";
@@ -0,0 +1,44 @@
+#pragma once
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hft {
+
+/**
+ * Pin the calling thread to one CPU core. Returns false if the core is
+ * invalid, the call is refused, or the platform has no affinity API.
+ */
+inline bool PinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * Run the calling thread under SCHED_FIFO at `priority` (1-99). Needs
+ * CAP_SYS_NICE or an RLIMIT_RTPRIO allowance; returns false otherwise.
+ * A spinning FIFO thread starves everything else on its core, so only
+ * combine this with a pinned, isolated core.
+ */
+inline bool SetRealtimePriority(int priority) {
+#ifdef __linux__
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
+}  // namespace hft
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "fixed_point.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 #include <chrono>
 
 namespace hft {
@@ -16,6 +20,12 @@ using Quantity = int64_t;
 
 using Timestamp = int64_t;
 
+// Dense per-process symbol index, assigned at subscribe time
+using SymbolId = uint32_t;
+
+// Price * Quantity accumulator; cumulative notional overflows 64 bits
+__extension__ typedef __int128 Notional;
+
 enum class Side : uint8_t {
     kBuy = 0,
     kSell = 1
@@ -30,6 +40,12 @@ struct PriceLevel {
     PriceLevel(Price p, Quantity q) : price(p), quantity(q) {}
 };
 
+// Fixed-point change to one price level; quantity 0 removes the level
+struct LevelDelta {
+    Price price;
+    Quantity quantity;
+};
+
 // Configuration for price/quantity conversion
 struct SymbolConfig {
     int price_decimals;
@@ -37,7 +53,13 @@ struct SymbolConfig {
 
     // Convert string to integer price
     // "30000.50" with decimals=2 -> 3000050
-    static int64_t StringToFixed(const std::string& s, int decimals) {
+    // Well-formed input takes the validating SWAR parser (ParseFixed);
+    // anything else keeps the lenient rules: stray characters are
+    // skipped and extra decimals truncated.
+    static int64_t StringToFixed(std::string_view s, int decimals) {
+        int64_t value;
+        if (ParseFixed(s, decimals, value)) return value;
+
         int64_t result = 0;
         bool found_dot = false;
         int decimal_count = 0;
@@ -64,19 +86,34 @@ struct SymbolConfig {
 
     // Convert integer price back to string
     // 3000050 with decimals=2 -> "30000.50"
+    // Allocates the result only; see FormatFixed to write into a buffer.
     static std::string FixedToString(int64_t value, int decimals) {
-        if (value == 0) return "0." + std::string(decimals, '0');
+        char buffer[kMaxFixedChars];
+        return std::string(buffer, FormatFixed(buffer, value, decimals));
+    }
+};
 
-        std::string s = std::to_string(value);
-        
-        while (static_cast<int>(s.length()) <= decimals) {
-            s = "0" + s;
-        }
+// Price and quantity text of one level
+struct LevelText {
+    FixedText price;
+    FixedText quantity;
+};
 
-        s.insert(s.length() - decimals, ".");
-        return s;
+/**
+ * Format a run of levels (e.g. a ladder from GetTopLevels) in one pass
+ * into a caller array. Returns the number formatted: the shorter length.
+ */
+inline size_t FormatLevels(std::span<const PriceLevel> levels,
+                           int price_decimals,
+                           int quantity_decimals,
+                           std::span<LevelText> out) {
+    size_t count = std::min(levels.size(), out.size());
+    for (size_t i = 0; i < count; ++i) {
+        out[i].price = FormatFixed(levels[i].price, price_decimals);
+        out[i].quantity = FormatFixed(levels[i].quantity, quantity_decimals);
     }
-};
+    return count;
+}
 
 // Get current timestamp in nanoseconds
 inline Timestamp NowNanos() {
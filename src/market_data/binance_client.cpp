@@ -1,16 +1,96 @@
 #include "binance_client.hpp"
 #include <boost/beast/http.hpp>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <nlohmann/json.hpp>  // Keep for REST API (simpler)
+#include "thread_tuning.hpp"
 
 namespace hft {
 
 namespace http = beast::http;
 
+#ifdef SO_BUSY_POLL
+// Microseconds the kernel may spin on the device queue before sleeping
+using BusyPollOption = net::detail::socket_option::integer<SOL_SOCKET, SO_BUSY_POLL>;
+#endif
+
+std::string BinanceClient::FetchDepthSnapshotBody(const std::string& symbol, int limit,
+                                                  std::chrono::milliseconds timeout,
+                                                  const std::atomic<bool>* cancel) {
+    // Every step is asynchronous and the loop below drives it in short
+    // slices, checking the deadline and the cancel flag in between.
+    // Abandoned operations die with the socket and the io_context.
+    constexpr auto kSlice = std::chrono::milliseconds(50);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    
+    net::io_context ioc;
+    ssl::context ctx{ssl::context::tlsv12_client};
+    ctx.set_default_verify_paths();
+    
+    tcp::resolver resolver(ioc);
+    beast::ssl_stream<tcp::socket> stream(ioc, ctx);
+    
+    auto run = [&](auto&& initiate) {
+        beast::error_code result;
+        bool done = false;
+        initiate([&](beast::error_code ec, auto&&...) {
+            result = ec;
+            done = true;
+        });
+        ioc.restart();
+        while (!done) {
+            if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+                throw std::runtime_error("snapshot fetch cancelled");
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw std::runtime_error("snapshot fetch timed out");
+            }
+            ioc.run_one_for(kSlice);
+        }
+        if (result) throw beast::system_error(result);
+    };
+    
+    SSL_set_tlsext_host_name(stream.native_handle(), "api.binance.com");
+    
+    tcp::resolver::results_type results;
+    run([&](auto handler) {
+        resolver.async_resolve("api.binance.com", "443",
+            [&results, handler](beast::error_code ec, tcp::resolver::results_type found) mutable {
+                results = std::move(found);
+                handler(ec);
+            });
+    });
+    run([&](auto handler) { net::async_connect(beast::get_lowest_layer(stream), results, handler); });
+    run([&](auto handler) { stream.async_handshake(ssl::stream_base::client, handler); });
+    
+    std::string upper_symbol = symbol;
+    for (char& c : upper_symbol) {
+        c = std::toupper(c);
+    }
+    std::string target = "/api/v3/depth?symbol=" + upper_symbol + "&limit=" + std::to_string(limit);
+    
+    http::request<http::string_body> req{http::verb::get, target, 11};
+    req.set(http::field::host, "api.binance.com");
+    req.set(http::field::user_agent, "hft-trading-system/1.0");
+    
+    run([&](auto handler) { http::async_write(stream, req, handler); });
+    
+    beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    run([&](auto handler) { http::async_read(stream, buffer, res, handler); });
+    
+    // The body is complete; close without a TLS shutdown round trip that
+    // could stall on the network
+    return std::move(res.body());
+}
+
 BinanceClient::BinanceClient()
     : resolver_(net::make_strand(ioc_)) {
+    snapshot_decoder_.Reserve(kMaxSnapshotLimit);
     ssl_ctx_.set_default_verify_paths();
     ssl_ctx_.set_verify_mode(ssl::verify_peer);
 }
@@ -19,20 +99,60 @@ BinanceClient::~BinanceClient() {
     Disconnect();
 }
 
-void BinanceClient::SetSymbol(const std::string& symbol) {
-    symbol_ = symbol;
-    for (char& c : symbol_) {
+void BinanceClient::AddSymbol(const std::string& symbol, SymbolId symbol_id,
+                              int price_decimals, int quantity_decimals) {
+    std::string lower = symbol;
+    for (char& c : lower) {
         c = std::tolower(c);
     }
+    for (auto& sub : subscriptions_) {
+        if (sub.symbol == lower) {
+            sub = Subscription{std::move(lower), symbol_id, price_decimals, quantity_decimals};
+            return;
+        }
+    }
+    subscriptions_.push_back(
+        Subscription{std::move(lower), symbol_id, price_decimals, quantity_decimals});
+}
+
+void BinanceClient::SetSymbol(const std::string& symbol, SymbolId symbol_id) {
+    int price_decimals = subscriptions_.empty() ? 2 : subscriptions_.front().price_decimals;
+    int quantity_decimals = subscriptions_.empty() ? 8 : subscriptions_.front().quantity_decimals;
+    subscriptions_.clear();
+    AddSymbol(symbol, symbol_id, price_decimals, quantity_decimals);
+}
+
+void BinanceClient::SetPrecision(int price_decimals, int quantity_decimals) {
+    for (auto& sub : subscriptions_) {
+        sub.price_decimals = price_decimals;
+        sub.quantity_decimals = quantity_decimals;
+    }
 }
 
 void BinanceClient::Connect() {
     if (running_) return;
+    if (subscriptions_.empty()) {
+        if (on_error_) on_error_("Connect failed: no symbols subscribed");
+        return;
+    }
     
     running_ = true;
     
-    ws_ = std::make_unique<websocket::stream<beast::ssl_stream<tcp::socket>>>(
-        net::make_strand(ioc_), ssl_ctx_);
+    std::vector<std::string> symbols;
+    for (const auto& sub : subscriptions_) {
+        symbols.push_back(sub.symbol);
+    }
+    router_.Build(symbols);
+    
+    legs_.clear();
+    for (size_t i = 0; i < leg_count_; ++i) {
+        auto leg = std::make_unique<FeedLeg>();
+        leg->ws = std::make_unique<WebSocket>(net::make_strand(ioc_), ssl_ctx_);
+        leg->buffer.reserve(kReadBufferReserve);
+        legs_.push_back(std::move(leg));
+    }
+    connected_legs_ = 0;
+    arbiter_.Reset(leg_count_);
     
     DoConnect();
     
@@ -58,8 +178,24 @@ void BinanceClient::Disconnect() {
 }
 
 void BinanceClient::RunIoContext() {
+    if (io_config_.cpu >= 0 && !PinCurrentThread(io_config_.cpu) && on_error_) {
+        on_error_("Could not pin I/O thread to CPU " + std::to_string(io_config_.cpu));
+    }
+    if (io_config_.realtime_priority > 0 &&
+        !SetRealtimePriority(io_config_.realtime_priority) && on_error_) {
+        on_error_("Could not set SCHED_FIFO priority " +
+                  std::to_string(io_config_.realtime_priority));
+    }
+    
     try {
-        ioc_.run();
+        if (io_config_.mode == IoMode::kBusyPoll) {
+            // Never sleeps: a handler runs on the first pass after its data lands
+            while (running_ && !ioc_.stopped()) {
+                ioc_.poll();
+            }
+        } else {
+            ioc_.run();
+        }
     } catch (const std::exception& e) {
         if (on_error_) {
             on_error_(std::string("I/O error: ") + e.what());
@@ -81,160 +217,296 @@ void BinanceClient::OnResolve(beast::error_code ec, tcp::resolver::results_type
         return;
     }
     
-    net::async_connect(
-        beast::get_lowest_layer(*ws_),
-        results,
-        beast::bind_front_handler(&BinanceClient::OnConnect, shared_from_this())
-    );
+    // Leg i tries the endpoints starting from the i-th, so redundant legs
+    // take different network paths when the host resolves to several
+    std::vector<tcp::endpoint> endpoints(results.begin(), results.end());
+    for (size_t leg = 0; leg < legs_.size(); ++leg) {
+        std::vector<tcp::endpoint> order = endpoints;
+        if (!order.empty()) {
+            std::rotate(order.begin(), order.begin() + leg % order.size(), order.end());
+        }
+        net::async_connect(
+            beast::get_lowest_layer(*legs_[leg]->ws),
+            order,
+            beast::bind_front_handler(&BinanceClient::OnConnect, shared_from_this(), leg)
+        );
+    }
 }
 
-void BinanceClient::OnConnect(beast::error_code ec, 
-                               [[maybe_unused]] tcp::resolver::results_type::endpoint_type ep) {
+void BinanceClient::OnConnect(size_t leg, beast::error_code ec, [[maybe_unused]] tcp::endpoint ep) {
     if (ec) {
         if (on_error_) on_error_("Connect failed: " + ec.message());
         return;
     }
     
-    if (!SSL_set_tlsext_host_name(ws_->next_layer().native_handle(), host_.c_str())) {
+    WebSocket& ws = *legs_[leg]->ws;
+    if (io_config_.busy_poll_usec > 0) {
+#ifdef SO_BUSY_POLL
+        beast::error_code option_ec;
+        beast::get_lowest_layer(ws).set_option(BusyPollOption(io_config_.busy_poll_usec), option_ec);
+        if (option_ec && on_error_) on_error_("SO_BUSY_POLL failed: " + option_ec.message());
+#else
+        if (on_error_) on_error_("SO_BUSY_POLL not supported on this platform");
+#endif
+    }
+    
+    if (!SSL_set_tlsext_host_name(ws.next_layer().native_handle(), host_.c_str())) {
         if (on_error_) on_error_("SSL SNI failed");
         return;
     }
     
-    ws_->next_layer().async_handshake(
+    ws.next_layer().async_handshake(
         ssl::stream_base::client,
-        beast::bind_front_handler(&BinanceClient::OnSslHandshake, shared_from_this())
+        beast::bind_front_handler(&BinanceClient::OnSslHandshake, shared_from_this(), leg)
     );
 }
 
-void BinanceClient::OnSslHandshake(beast::error_code ec) {
+void BinanceClient::OnSslHandshake(size_t leg, beast::error_code ec) {
     if (ec) {
         if (on_error_) on_error_("SSL handshake failed: " + ec.message());
         return;
     }
     
-    ws_->set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
-    ws_->set_option(websocket::stream_base::decorator([](websocket::request_type& req) {
+    WebSocket& ws = *legs_[leg]->ws;
+    ws.set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
+    ws.set_option(websocket::stream_base::decorator([](websocket::request_type& req) {
         req.set(http::field::user_agent, "hft-trading-system/1.0");
     }));
     
-    std::string path = "/ws/" + symbol_ + "@depth@100ms";
-    
-    ws_->async_handshake(
+    ws.async_handshake(
         host_,
-        path,
-        beast::bind_front_handler(&BinanceClient::OnHandshake, shared_from_this())
+        StreamPath(),
+        beast::bind_front_handler(&BinanceClient::OnHandshake, shared_from_this(), leg)
     );
 }
 
-void BinanceClient::OnHandshake(beast::error_code ec) {
+void BinanceClient::OnHandshake(size_t leg, beast::error_code ec) {
     if (ec) {
         if (on_error_) on_error_("WebSocket handshake failed: " + ec.message());
         return;
     }
     
-    connected_ = true;
-    
-    if (on_connected_) {
-        on_connected_();
+    legs_[leg]->connected = true;
+    if (connected_legs_++ == 0) {
+        connected_ = true;
+        if (on_connected_) {
+            on_connected_();
+        }
     }
     
-    DoRead();
+    DoRead(leg);
 }
 
-void BinanceClient::DoRead() {
+std::string BinanceClient::StreamPath() const {
+    // Every stream of every symbol on one combined connection
+    std::string path = "/stream?streams=";
+    bool first = true;
+    auto add = [&](const std::string& stream) {
+        if (!first) path += '/';
+        path += stream;
+        first = false;
+    };
+    for (const auto& sub : subscriptions_) {
+        add(sub.symbol + "@depth@100ms");
+        if (subscribe_trades_) add(sub.symbol + "@trade");
+        if (subscribe_agg_trades_) add(sub.symbol + "@aggTrade");
+        if (subscribe_book_ticker_) add(sub.symbol + "@bookTicker");
+    }
+    return path;
+}
+
+void BinanceClient::DoRead(size_t leg) {
     if (!running_) return;
     
-    ws_->async_read(
-        buffer_,
-        beast::bind_front_handler(&BinanceClient::OnRead, shared_from_this())
+    legs_[leg]->ws->async_read(
+        legs_[leg]->buffer,
+        beast::bind_front_handler(&BinanceClient::OnRead, shared_from_this(), leg)
     );
 }
 
-void BinanceClient::OnRead(beast::error_code ec, std::size_t bytes_transferred) {
+void BinanceClient::OnRead(size_t leg, beast::error_code ec, std::size_t bytes_transferred) {
     if (ec) {
-        if (ec == websocket::error::closed) {
-            connected_ = false;
-            if (on_disconnected_) on_disconnected_();
-        } else if (running_) {
+        // Every read error ends the leg; only an unclean one is reported
+        if (ec != websocket::error::closed && running_) {
             if (on_error_) on_error_("Read error: " + ec.message());
         }
+        OnLegClosed(leg);
         return;
     }
     
     bytes_received_ += bytes_transferred;
     messages_received_++;
     
-    std::string message = beast::buffers_to_string(buffer_.data());
-    buffer_.consume(buffer_.size());
+    // Keep SIMDJSON_PADDING bytes of slack after the frame so simdjson can
+    // parse it where it landed. Only reallocates while the buffer grows.
+    beast::flat_buffer& buffer = legs_[leg]->buffer;
+    buffer.prepare(simdjson::SIMDJSON_PADDING);
+    auto frame = buffer.data();
+    HandleMessage(simdjson::padded_string_view(
+        static_cast<const char*>(frame.data()), frame.size(),
+        frame.size() + simdjson::SIMDJSON_PADDING), leg);
+    buffer.consume(buffer.size());
+    
+    DoRead(leg);
+}
+
+// Connected until the last leg goes away
+void BinanceClient::OnLegClosed(size_t leg) {
+    if (!legs_[leg]->connected) return;
+    legs_[leg]->connected = false;
+    if (--connected_legs_ == 0) {
+        connected_ = false;
+        if (on_disconnected_) on_disconnected_();
+    }
+}
+
+void BinanceClient::HandleMessage(simdjson::padded_string_view message, size_t leg) {
+    // Split the combined-stream envelope without parsing the payload
+    StreamEnvelope envelope;
+    if (!UnwrapEnvelope(message, envelope) && !json_parser_.ParseEnvelope(message, envelope)) {
+        return;
+    }
     
-    HandleMessage(message);
+    // Route on the symbol part of "<symbol>@<stream>"
+    std::string_view stream_symbol = envelope.stream.substr(0, envelope.stream.find('@'));
+    uint32_t index = router_.Find(stream_symbol);
+    if (index == StreamRouter::kNotFound) return;
+    const Subscription& sub = subscriptions_[index];
     
-    DoRead();
+    // Dispatch on the event type without a full parse
+    EventType type = PeekEventType(envelope.data);
+    if (type == EventType::kUnknown) {
+        type = json_parser_.ParseEventType(envelope.data);
+    }
+    if (type == EventType::kUnknown) return;
+    
+    // Redundant legs: only the first copy of each event goes on
+    if (legs_.size() > 1 && !Arbitrate(type, envelope.data, sub, leg)) return;
+    
+    switch (type) {
+        case EventType::kDepthUpdate:
+            HandleDepthUpdate(envelope.data, sub);
+            break;
+        case EventType::kTrade:
+        case EventType::kAggTrade:
+            HandleTrade(envelope.data, sub);
+            break;
+        case EventType::kBookTicker:
+            HandleBookTicker(envelope.data, sub);
+            break;
+        case EventType::kUnknown:
+            break;
+    }
 }
 
-void BinanceClient::HandleMessage(const std::string& message) {
-    // Use simdjson for fast parsing
-    DepthUpdate update;
-    if (json_parser_.ParseDepthUpdate(message, update)) {
-        if (on_depth_update_) {
-            on_depth_update_(update);
-        }
+bool BinanceClient::Arbitrate(EventType type, simdjson::padded_string_view message,
+                              const Subscription& sub, size_t leg) {
+    // Ids are read before any decoding, so losing copies cost one scan
+    std::string_view key = "u";
+    if (type == EventType::kTrade) key = "t";
+    if (type == EventType::kAggTrade) key = "a";
+    
+    int64_t id;
+    if (!PeekInteger(message, key, id) && !json_parser_.ParseInteger(message, key, id)) {
+        return true;  // No id to key on: deliver rather than drop
     }
+    return arbiter_.Accept(type, sub.symbol_id, id, leg, NowNanos());
 }
 
-void BinanceClient::DoClose() {
-    if (!ws_) return;
+void BinanceClient::HandleTrade(simdjson::padded_string_view message, const Subscription& sub) {
+    if (!on_trade_) return;
     
-    beast::error_code ec;
-    ws_->close(websocket::close_code::normal, ec);
+    TradeEvent trade;
+    if (json_parser_.ParseTrade(message, sub.price_decimals, sub.quantity_decimals, trade)) {
+        trade.symbol_id = sub.symbol_id;
+        on_trade_(trade);
+    }
 }
 
-void BinanceClient::OnClose([[maybe_unused]] beast::error_code ec) {
-    connected_ = false;
-    if (on_disconnected_) {
-        on_disconnected_();
+void BinanceClient::HandleBookTicker(simdjson::padded_string_view message,
+                                     const Subscription& sub) {
+    if (!on_book_ticker_) return;
+    
+    BookTicker ticker;
+    if (book_ticker_decoder_.Decode(message, sub.price_decimals, sub.quantity_decimals, ticker)) {
+        ticker.symbol_id = sub.symbol_id;
+        on_book_ticker_(ticker);
     }
 }
 
-DepthSnapshot BinanceClient::FetchDepthSnapshot(int limit) {
-    // Use nlohmann/json for REST (simpler, not performance critical)
-    net::io_context ioc;
-    ssl::context ctx{ssl::context::tlsv12_client};
-    ctx.set_default_verify_paths();
-    
-    tcp::resolver resolver(ioc);
-    beast::ssl_stream<tcp::socket> stream(ioc, ctx);
-    
-    SSL_set_tlsext_host_name(stream.native_handle(), "api.binance.com");
-    
-    auto const results = resolver.resolve("api.binance.com", "443");
-    net::connect(beast::get_lowest_layer(stream), results);
-    stream.handshake(ssl::stream_base::client);
-    
-    std::string upper_symbol = symbol_;
-    for (char& c : upper_symbol) {
-        c = std::toupper(c);
+void BinanceClient::HandleDepthUpdate(simdjson::padded_string_view message,
+                                      const Subscription& sub) {
+    // Fused path: levels converted to fixed point during the parse
+    if (on_depth_deltas_) {
+        DepthDeltas deltas;
+        if (json_parser_.ParseDepthUpdate(message, sub.price_decimals, sub.quantity_decimals, deltas)) {
+            deltas.symbol_id = sub.symbol_id;
+            on_depth_deltas_(deltas);
+        }
     }
-    std::string target = "/api/v3/depth?symbol=" + upper_symbol + "&limit=" + std::to_string(limit);
     
-    http::request<http::string_body> req{http::verb::get, target, 11};
-    req.set(http::field::host, "api.binance.com");
-    req.set(http::field::user_agent, "hft-trading-system/1.0");
+    if (!on_depth_update_view_ && !on_depth_update_) return;
     
-    http::write(stream, req);
-    
-    beast::flat_buffer buffer;
-    http::response<http::string_body> res;
-    http::read(stream, buffer, res);
+    // Use simdjson for fast parsing; levels stay views into the parser
+    DepthUpdateView update;
+    if (json_parser_.ParseDepthUpdate(message, update)) {
+        update.symbol_id = sub.symbol_id;
+        if (on_depth_update_view_) {
+            on_depth_update_view_(update);
+        }
+        if (on_depth_update_) {
+            update.CopyTo(depth_update_);
+            on_depth_update_(depth_update_);
+        }
+    }
+}
+
+void BinanceClient::DoClose() {
+    for (auto& leg : legs_) {
+        if (!leg->connected) continue;
+        beast::error_code ec;
+        leg->ws->close(websocket::close_code::normal, ec);
+    }
+}
+
+void BinanceClient::Post(std::function<void()> task) {
+    net::post(ioc_, std::move(task));
+}
+
+DepthSnapshot BinanceClient::FetchDepthSnapshot(int limit) {
+    return FetchDepthSnapshot(subscriptions_.empty() ? std::string() : subscriptions_.front().symbol,
+                              limit);
+}
+
+DepthSnapshot BinanceClient::FetchDepthSnapshot(const std::string& symbol, int limit) {
+    std::string body = FetchDepthSnapshotBody(symbol, limit);
     
-    // Parse with simdjson
+    // Parse with simdjson; own parser so views handed out by
+    // json_parser_ stay valid if this is called from a depth callback
     DepthSnapshot snapshot;
-    json_parser_.ParseDepthSnapshot(res.body(), snapshot);
-    
-    beast::error_code ec;
-    stream.shutdown(ec);
-    
+    FastJsonParser snapshot_parser;
+    snapshot_parser.ParseDepthSnapshot(body, snapshot);
     return snapshot;
 }
 
+bool BinanceClient::FetchDepthSnapshot(const std::string& symbol,
+                                       DepthSnapshotDeltas& snapshot,
+                                       int limit) {
+    std::string lower = symbol;
+    for (char& c : lower) {
+        c = std::tolower(c);
+    }
+    auto sub = std::find_if(subscriptions_.begin(), subscriptions_.end(),
+                            [&](const Subscription& s) { return s.symbol == lower; });
+    if (sub == subscriptions_.end()) return false;
+    
+    // Pad the body where it is and decode it in place
+    std::string body = FetchDepthSnapshotBody(symbol, limit);
+    size_t size = body.size();
+    body.reserve(size + simdjson::SIMDJSON_PADDING);
+    return snapshot_decoder_.Decode(
+        simdjson::padded_string_view(body.data(), size, body.capacity()),
+        sub->price_decimals, sub->quantity_decimals, snapshot);
+}
+
 }  // namespace hft
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <functional>
 #include <memory>
@@ -17,6 +19,9 @@
 
 #include "order_book.hpp"
 #include "binance_messages.hpp"
+#include "depth_decoder.hpp"
+#include "feed_arbiter.hpp"
+#include "stream_router.hpp"
 
 namespace hft {
 
@@ -28,69 +33,195 @@ using tcp = boost::asio::ip::tcp;
 
 // Callback types
 using OnDepthUpdate = std::function<void(const DepthUpdate&)>;
+using OnDepthUpdateView = std::function<void(const DepthUpdateView&)>;  // Valid during the call only
+using OnDepthDeltas = std::function<void(const DepthDeltas&)>;          // Valid during the call only
 using OnTrade = std::function<void(const TradeEvent&)>;
+using OnBookTicker = std::function<void(const BookTicker&)>;
 using OnError = std::function<void(const std::string&)>;
 using OnConnected = std::function<void()>;
 using OnDisconnected = std::function<void()>;
 
+// How the I/O thread waits for network events
+enum class IoMode : uint8_t {
+    kBlocking,  // ioc.run(): sleeps in epoll between frames
+    kBusyPoll   // Spins on ioc.poll(): no wakeup latency, burns the core
+};
+
+struct IoConfig {
+    IoMode mode = IoMode::kBlocking;
+    int cpu = -1;               // Pin the I/O thread to this core (-1: no pinning)
+    int realtime_priority = 0;  // SCHED_FIFO priority for the I/O thread (0: leave as is)
+    int busy_poll_usec = 0;     // SO_BUSY_POLL on every leg socket (0: off; Linux only)
+};
+
 /**
  * Binance WebSocket client for market data streaming.
  * Uses simdjson for fast JSON parsing.
+ *
+ * All subscribed symbols share one combined-stream connection
+ * (/stream?streams=...). Each message's envelope names its stream; the
+ * symbol part is routed to its subscription through a perfect hash built
+ * at Connect().
+ *
+ * With SetFeedLegs(n > 1) the same streams are read over n concurrent
+ * connections, spread across the resolved endpoints, and a FeedArbiter
+ * delivers each event once from whichever leg has it first.
  */
 class BinanceClient : public std::enable_shared_from_this<BinanceClient> {
 public:
     BinanceClient();
     ~BinanceClient();
     
-    // Configuration
-    void SetSymbol(const std::string& symbol);
+    // Configuration (before Connect)
+    
+    /**
+     * Add a symbol to the combined stream. symbol_id is stamped on its
+     * events; the precision is used by the OnDepthDeltas, OnTrade and
+     * OnBookTicker paths.
+     */
+    void AddSymbol(const std::string& symbol, SymbolId symbol_id,
+                   int price_decimals = 2, int quantity_decimals = 8);
+    
+    // Replace all subscriptions with a single symbol
+    void SetSymbol(const std::string& symbol, SymbolId symbol_id = 0);
+    
+    // Precision for every subscribed symbol
+    void SetPrecision(int price_decimals, int quantity_decimals);
+    
+    // Also subscribe to <symbol>@trade / <symbol>@aggTrade for every symbol
+    void SubscribeTrades(bool enable = true) { subscribe_trades_ = enable; }
+    void SubscribeAggTrades(bool enable = true) { subscribe_agg_trades_ = enable; }
+    
+    // Also subscribe to <symbol>@bookTicker: real-time best bid/ask
+    void SubscribeBookTicker(bool enable = true) { subscribe_book_ticker_ = enable; }
+    
+    // I/O thread wait mode, pinning and priority
+    void SetIoConfig(const IoConfig& config) { io_config_ = config; }
+    
+    // Redundant connections carrying the same streams (A/B feed); 1 = no arbitration
+    void SetFeedLegs(size_t count) { leg_count_ = std::max<size_t>(count, 1); }
     
     // Callbacks
     void SetOnDepthUpdate(OnDepthUpdate callback) { on_depth_update_ = callback; }
+    void SetOnDepthUpdateView(OnDepthUpdateView callback) { on_depth_update_view_ = callback; }
+    void SetOnDepthDeltas(OnDepthDeltas callback) { on_depth_deltas_ = callback; }
     void SetOnTrade(OnTrade callback) { on_trade_ = callback; }
+    void SetOnBookTicker(OnBookTicker callback) { on_book_ticker_ = callback; }
     void SetOnError(OnError callback) { on_error_ = callback; }
     void SetOnConnected(OnConnected callback) { on_connected_ = callback; }
     void SetOnDisconnected(OnDisconnected callback) { on_disconnected_ = callback; }
     
-    // Connection control
+    // Connection control; connected while any leg is. Connect() reports
+    // an error and does nothing until a symbol has been added.
     void Connect();
     void Disconnect();
     bool IsConnected() const { return connected_; }
     
+    // Run a task on the I/O thread, where the callbacks run (thread-safe)
+    void Post(std::function<void()> task);
+    
+    // Deepest snapshot the REST API serves
+    static constexpr int kMaxSnapshotLimit = 5000;
+    
+    // Longest a snapshot request may take, connect to last body byte
+    static constexpr std::chrono::milliseconds kSnapshotTimeout{10000};
+    
+    /**
+     * GET /api/v3/depth and return the raw body. Blocking; throws on
+     * network errors, after `timeout`, or within ~50 ms of `*cancel`
+     * becoming true. Uses no client state, so it can run on any thread,
+     * e.g. as a BookSynchronizer fetcher.
+     */
+    static std::string FetchDepthSnapshotBody(const std::string& symbol,
+                                              int limit = kMaxSnapshotLimit,
+                                              std::chrono::milliseconds timeout = kSnapshotTimeout,
+                                              const std::atomic<bool>* cancel = nullptr);
+    
     // Fetch snapshot via REST API (blocking call)
-    DepthSnapshot FetchDepthSnapshot(int limit = 1000);
+    DepthSnapshot FetchDepthSnapshot(const std::string& symbol, int limit = 1000);
+    DepthSnapshot FetchDepthSnapshot(int limit = 1000);  // First subscribed symbol
+    
+    /**
+     * Fetch a snapshot of a subscribed symbol and convert it straight to
+     * fixed point with that subscription's precision, parsing the response
+     * body in place. Levels point into a client-owned pool (sized for
+     * kMaxSnapshotLimit) until the next call. Blocking; throws on network
+     * errors, returns false if the symbol is unknown or the body invalid.
+     */
+    bool FetchDepthSnapshot(const std::string& symbol,
+                            DepthSnapshotDeltas& snapshot,
+                            int limit = kMaxSnapshotLimit);
     
     // Statistics
     uint64_t GetMessagesReceived() const { return messages_received_; }
     uint64_t GetBytesReceived() const { return bytes_received_; }
+    
+    // Per-leg win rate and lag; read once the I/O thread is stopped
+    size_t GetFeedLegCount() const { return leg_count_; }
+    const FeedArbiter& GetArbiter() const { return arbiter_; }
 
 private:
+    using WebSocket = websocket::stream<beast::ssl_stream<tcp::socket>>;
+    
+    // One connection carrying every stream
+    struct FeedLeg {
+        std::unique_ptr<WebSocket> ws;
+        beast::flat_buffer buffer;  // Frames are parsed in place, see OnRead
+        bool connected = false;
+    };
+    
     void RunIoContext();
     void DoConnect();
     void OnResolve(beast::error_code ec, tcp::resolver::results_type results);
-    void OnConnect(beast::error_code ec, tcp::resolver::results_type::endpoint_type ep);
-    void OnSslHandshake(beast::error_code ec);
-    void OnHandshake(beast::error_code ec);
-    void DoRead();
-    void OnRead(beast::error_code ec, std::size_t bytes_transferred);
-    void HandleMessage(const std::string& message);
+    void OnConnect(size_t leg, beast::error_code ec, tcp::endpoint ep);
+    void OnSslHandshake(size_t leg, beast::error_code ec);
+    void OnHandshake(size_t leg, beast::error_code ec);
+    void DoRead(size_t leg);
+    void OnRead(size_t leg, beast::error_code ec, std::size_t bytes_transferred);
+    void OnLegClosed(size_t leg);
+    struct Subscription {
+        std::string symbol;  // Lowercase, as in stream names
+        SymbolId symbol_id;
+        int price_decimals;
+        int quantity_decimals;
+    };
+    
+    std::string StreamPath() const;
+    void HandleMessage(simdjson::padded_string_view message, size_t leg);
+    bool Arbitrate(EventType type, simdjson::padded_string_view message,
+                   const Subscription& sub, size_t leg);
+    void HandleDepthUpdate(simdjson::padded_string_view message, const Subscription& sub);
+    void HandleTrade(simdjson::padded_string_view message, const Subscription& sub);
+    void HandleBookTicker(simdjson::padded_string_view message, const Subscription& sub);
     void DoClose();
-    void OnClose(beast::error_code ec);
+    
+    // Initial read buffer; depth@100ms frames are a few KB
+    static constexpr size_t kReadBufferReserve = 64 * 1024;
     
     // Configuration
-    std::string symbol_ = "btcusdt";
+    std::vector<Subscription> subscriptions_;
+    StreamRouter router_;  // Stream symbol -> index into subscriptions_
+    bool subscribe_trades_ = false;
+    bool subscribe_agg_trades_ = false;
+    bool subscribe_book_ticker_ = false;
     std::string host_ = "stream.binance.com";
     std::string port_ = "9443";
+    size_t leg_count_ = 1;
+    IoConfig io_config_;
     
     // Boost.Asio components
     net::io_context ioc_;
     ssl::context ssl_ctx_{ssl::context::tlsv12_client};
-    std::unique_ptr<websocket::stream<beast::ssl_stream<tcp::socket>>> ws_;
+    std::vector<std::unique_ptr<FeedLeg>> legs_;
+    size_t connected_legs_ = 0;  // I/O thread only
     tcp::resolver resolver_;
-    beast::flat_buffer buffer_;
+    FeedArbiter arbiter_{0};  // Sized at Connect()
     
     // Fast JSON parser (reused)
     FastJsonParser json_parser_;
+    DepthSnapshotDecoder snapshot_decoder_;  // Own pools: used from inside depth callbacks
+    BookTickerDecoder book_ticker_decoder_;
+    DepthUpdate depth_update_;  // Owning copy, only filled for on_depth_update_
     
     // Thread management
     std::thread io_thread_;
@@ -99,7 +230,10 @@ private:
     
     // Callbacks
     OnDepthUpdate on_depth_update_;
+    OnDepthUpdateView on_depth_update_view_;
+    OnDepthDeltas on_depth_deltas_;
     OnTrade on_trade_;
+    OnBookTicker on_book_ticker_;
     OnError on_error_;
     OnConnected on_connected_;
     OnDisconnected on_disconnected_;
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <simdjson.h>
 #include "types.hpp"
@@ -10,12 +12,65 @@ namespace hft {
 // Depth update from WebSocket stream
 struct DepthUpdate {
     std::string symbol;
+    SymbolId symbol_id = 0;  // Stamped by the client from its subscription
     int64_t first_update_id;
     int64_t final_update_id;
     std::vector<std::pair<std::string, std::string>> bids;
     std::vector<std::pair<std::string, std::string>> asks;
 };
 
+// Price and quantity text of one level, as sent
+struct LevelView {
+    std::string_view price;
+    std::string_view quantity;
+};
+
+/**
+ * Depth update whose strings and level arrays point into the parser that
+ * produced it. Valid until that parser's next Parse call.
+ */
+struct DepthUpdateView {
+    std::string_view symbol;
+    SymbolId symbol_id = 0;  // Stamped by the client from its subscription
+    int64_t first_update_id = 0;
+    int64_t final_update_id = 0;
+    std::span<const LevelView> bids;
+    std::span<const LevelView> asks;
+
+    /**
+     * Copy into an owning DepthUpdate, reusing its storage.
+     */
+    void CopyTo(DepthUpdate& update) const {
+        update.symbol.assign(symbol);
+        update.symbol_id = symbol_id;
+        update.first_update_id = first_update_id;
+        update.final_update_id = final_update_id;
+        auto copy_levels = [](std::span<const LevelView> from, auto& to) {
+            to.resize(from.size());
+            for (size_t i = 0; i < from.size(); ++i) {
+                to[i].first.assign(from[i].price);
+                to[i].second.assign(from[i].quantity);
+            }
+        };
+        copy_levels(bids, update.bids);
+        copy_levels(asks, update.asks);
+    }
+};
+
+/**
+ * Depth update with levels already converted to fixed point, ready for
+ * OrderBook::ApplyBatch. Level arrays point into the parser's pools and
+ * are valid until its next Parse call.
+ */
+struct DepthDeltas {
+    std::string_view symbol;
+    SymbolId symbol_id = 0;  // Stamped by the client from its subscription
+    int64_t first_update_id = 0;
+    int64_t final_update_id = 0;
+    std::span<const LevelDelta> bids;
+    std::span<const LevelDelta> asks;
+};
+
 // Depth snapshot from REST API
 struct DepthSnapshot {
     int64_t last_update_id;
@@ -23,28 +78,445 @@ struct DepthSnapshot {
     std::vector<std::pair<std::string, std::string>> asks;
 };
 
-// Trade event from WebSocket
+/**
+ * Depth snapshot with levels already in fixed point, best-first as sent.
+ * The level arrays point into the parser or decoder that produced it.
+ */
+struct DepthSnapshotDeltas {
+    int64_t last_update_id = 0;
+    std::span<const LevelDelta> bids;
+    std::span<const LevelDelta> asks;
+};
+
+/**
+ * Trade print from the @trade or @aggTrade stream. Plain data: fixed-point
+ * price and quantity, symbol identified by id only.
+ */
 struct TradeEvent {
-    std::string symbol;
-    int64_t trade_id;
-    std::string price;
-    std::string quantity;
-    int64_t trade_time;
-    bool is_buyer_maker;
+    SymbolId symbol_id = 0;     // Stamped by the client from its subscription
+    int64_t trade_id = 0;       // "t", or the aggregate id "a"
+    int64_t first_trade_id = 0; // aggTrade "f"; trade_id for single trades
+    int64_t last_trade_id = 0;  // aggTrade "l"; trade_id for single trades
+    Price price = 0;
+    Quantity quantity = 0;
+    Timestamp event_time = 0;   // "E", exchange milliseconds
+    Timestamp trade_time = 0;   // "T", exchange milliseconds
+    bool is_buyer_maker = false;
+    bool is_aggregate = false;
 };
 
+/**
+ * Best bid/ask from the @bookTicker stream, pushed on every touch change.
+ * update_id is in the same sequence as the depth stream's update ids.
+ */
+struct BookTicker {
+    SymbolId symbol_id = 0;     // Stamped by the client from its subscription
+    int64_t update_id = 0;      // "u"
+    Price bid_price = 0;        // "b"
+    Quantity bid_quantity = 0;  // "B"
+    Price ask_price = 0;        // "a"
+    Quantity ask_quantity = 0;  // "A"
+};
+
+// Payload kinds delivered on a Binance stream
+enum class EventType : uint8_t {
+    kUnknown,
+    kDepthUpdate,
+    kTrade,
+    kAggTrade,
+    kBookTicker
+};
+
+/**
+ * One message of a combined stream: {"stream":"<name>","data":{...}}.
+ * `data` is a view into the same buffer, keeping its padding.
+ */
+struct StreamEnvelope {
+    std::string_view stream;
+    simdjson::padded_string_view data;
+};
+
+/**
+ * Split a compact combined-stream envelope without parsing the payload.
+ * Returns false for any other layout; use FastJsonParser::ParseEnvelope()
+ * as the fallback.
+ */
+inline bool UnwrapEnvelope(simdjson::padded_string_view message, StreamEnvelope& envelope) {
+    constexpr std::string_view kPrefix = R"({"stream":")";
+    constexpr std::string_view kData = R"(","data":)";
+    std::string_view json = message;
+    if (!json.starts_with(kPrefix) || !json.ends_with('}')) return false;
+
+    size_t name_end = json.find('"', kPrefix.size());
+    if (name_end == std::string_view::npos) return false;
+    if (json.substr(name_end, kData.size()) != kData) return false;
+
+    size_t data_begin = name_end + kData.size();
+    size_t data_end = json.size() - 1;  // Outer closing brace
+    if (data_begin >= data_end) return false;
+
+    envelope.stream = json.substr(kPrefix.size(), name_end - kPrefix.size());
+    envelope.data = simdjson::padded_string_view(json.data() + data_begin,
+                                                 data_end - data_begin,
+                                                 message.capacity() - data_begin);
+    return true;
+}
+
+/**
+ * Event type from the leading {"e":"..." of a compact Binance payload,
+ * without parsing. Spot bookTicker carries no "e" and starts with {"u":.
+ * Returns kUnknown for any other layout; use
+ * FastJsonParser::ParseEventType() as the fallback.
+ */
+inline EventType PeekEventType(std::string_view json) {
+    constexpr std::string_view kPrefix = R"({"e":")";
+    if (json.starts_with(R"({"u":)")) return EventType::kBookTicker;
+    if (json.substr(0, kPrefix.size()) != kPrefix) return EventType::kUnknown;
+    std::string_view rest = json.substr(kPrefix.size());
+    if (rest.starts_with(R"(depthUpdate")")) return EventType::kDepthUpdate;
+    if (rest.starts_with(R"(trade")")) return EventType::kTrade;
+    if (rest.starts_with(R"(aggTrade")")) return EventType::kAggTrade;
+    if (rest.starts_with(R"(bookTicker")")) return EventType::kBookTicker;
+    return EventType::kUnknown;
+}
+
+/**
+ * Unsigned integer value of the top-level `"key":` in a compact payload,
+ * without parsing. Meant for ids that precede any nested field (the
+ * depthUpdate/bookTicker "u", trade "t", aggTrade "a"). Returns false if
+ * the key is absent or its value is not a plain integer; use
+ * FastJsonParser::ParseInteger() as the fallback.
+ */
+inline bool PeekInteger(std::string_view json, std::string_view key, int64_t& value) {
+    for (size_t pos = json.find(key); pos != std::string_view::npos;
+         pos = json.find(key, pos + 1)) {
+        size_t end = pos + key.size();
+        if (pos == 0 || json[pos - 1] != '"' || end + 1 >= json.size() ||
+            json[end] != '"' || json[end + 1] != ':') {
+            continue;
+        }
+        size_t start = end + 2;
+        size_t stop = start;
+        while (stop < json.size() && json[stop] >= '0' && json[stop] <= '9') ++stop;
+        return stop != start && ParseFixed(json.substr(start, stop - start), 0, value);
+    }
+    return false;
+}
+
 /**
  * Fast JSON parser using simdjson.
- * Reuses parser and padded_string to avoid allocation.
+ * Reuses the parser, the padded input buffer and the level arrays, so
+ * steady-state parsing does not allocate. The padded_string_view
+ * overloads parse directly in the caller's buffer with no copy.
  */
 class FastJsonParser {
 public:
     FastJsonParser() = default;
     
-    // Parse depth update from WebSocket
-    bool ParseDepthUpdate(const std::string& json, DepthUpdate& update) {
-        padded_ = simdjson::padded_string(json);
-        auto doc = parser_.iterate(padded_);
+    /**
+     * Parse a depth update without copying any strings. The returned view
+     * points into this parser's input buffer and level pools.
+     */
+    bool ParseDepthUpdate(std::string_view json, DepthUpdateView& update) {
+        return ParseDepthUpdate(Pad(json), update);
+    }
+    
+    /**
+     * Parse in place: `json` must stay alive and unchanged while the view
+     * is used, and have SIMDJSON_PADDING readable bytes past its end.
+     */
+    bool ParseDepthUpdate(simdjson::padded_string_view json, DepthUpdateView& update) {
+        bid_levels_.clear();
+        ask_levels_.clear();
+        bool ok = ParseDepth(json, update,
+            [&](Side side, std::string_view price, std::string_view quantity) {
+                (side == Side::kBuy ? bid_levels_ : ask_levels_).push_back({price, quantity});
+            });
+        update.bids = bid_levels_;
+        update.asks = ask_levels_;
+        return ok;
+    }
+    
+    /**
+     * Fused path: convert each price/quantity token to fixed point as the
+     * level arrays are walked, with no string stage in between. Fails if
+     * any number is malformed or not representable at the given precision.
+     */
+    bool ParseDepthUpdate(std::string_view json,
+                          int price_decimals,
+                          int quantity_decimals,
+                          DepthDeltas& update) {
+        return ParseDepthUpdate(Pad(json), price_decimals, quantity_decimals, update);
+    }
+    
+    // Fused path over a caller-owned padded buffer, parsed in place
+    bool ParseDepthUpdate(simdjson::padded_string_view json,
+                          int price_decimals,
+                          int quantity_decimals,
+                          DepthDeltas& update) {
+        bid_deltas_.clear();
+        ask_deltas_.clear();
+        bool numbers_valid = true;
+        bool ok = ParseDepth(json, update,
+            [&](Side side, std::string_view price, std::string_view quantity) {
+                LevelDelta delta;
+                numbers_valid &= ParseFixed(price, price_decimals, delta.price) &&
+                                 ParseFixed(quantity, quantity_decimals, delta.quantity);
+                (side == Side::kBuy ? bid_deltas_ : ask_deltas_).push_back(delta);
+            });
+        update.bids = bid_deltas_;
+        update.asks = ask_deltas_;
+        return ok && numbers_valid;
+    }
+    
+    // Parse depth update into owning strings
+    bool ParseDepthUpdate(std::string_view json, DepthUpdate& update) {
+        DepthUpdateView view;
+        if (!ParseDepthUpdate(json, view)) return false;
+        view.CopyTo(update);
+        return true;
+    }
+    
+    // Envelope via simdjson, for messages UnwrapEnvelope() rejects
+    bool ParseEnvelope(simdjson::padded_string_view message, StreamEnvelope& envelope) {
+        auto doc = parser_.iterate(message);
+        if (doc.error()) return false;
+        
+        if (!RawString(doc["stream"], envelope.stream)) return false;
+        
+        std::string_view data;
+        if (doc["data"].raw_json().get(data)) return false;
+        while (!data.empty() && IsJsonSpace(data.back())) data.remove_suffix(1);
+        size_t offset = static_cast<size_t>(data.data() - message.data());
+        envelope.data = simdjson::padded_string_view(data.data(), data.size(),
+                                                     message.capacity() - offset);
+        return true;
+    }
+    
+    // Event type via a keyed lookup, for payloads PeekEventType() rejects
+    EventType ParseEventType(simdjson::padded_string_view json) {
+        auto doc = parser_.iterate(json);
+        if (doc.error()) return EventType::kUnknown;
+        
+        auto event_result = doc["e"].get_string();
+        if (event_result.error()) {
+            // Spot bookTicker has no event type, only an update id
+            return doc["u"].error() ? EventType::kUnknown : EventType::kBookTicker;
+        }
+        std::string_view event_type = event_result.value();
+        if (event_type == "depthUpdate") return EventType::kDepthUpdate;
+        if (event_type == "trade") return EventType::kTrade;
+        if (event_type == "aggTrade") return EventType::kAggTrade;
+        if (event_type == "bookTicker") return EventType::kBookTicker;
+        return EventType::kUnknown;
+    }
+    
+    // Top-level integer field via a keyed lookup, for PeekInteger() misses
+    bool ParseInteger(simdjson::padded_string_view json, std::string_view key, int64_t& value) {
+        auto doc = parser_.iterate(json);
+        if (doc.error()) return false;
+        return !doc[key].get_int64().get(value);
+    }
+    
+    /**
+     * Parse a bookTicker message, converting prices and quantities to
+     * fixed point. Returns false on a missing field or invalid number.
+     */
+    bool ParseBookTicker(simdjson::padded_string_view json,
+                         int price_decimals,
+                         int quantity_decimals,
+                         BookTicker& ticker) {
+        auto doc = parser_.iterate(json);
+        if (doc.error()) return false;
+        
+        auto id_result = doc["u"].get_int64();
+        if (id_result.error()) return false;
+        ticker.update_id = id_result.value();
+        
+        std::string_view bid_price, bid_quantity, ask_price, ask_quantity;
+        if (!RawString(doc["b"], bid_price) || !RawString(doc["B"], bid_quantity) ||
+            !RawString(doc["a"], ask_price) || !RawString(doc["A"], ask_quantity)) {
+            return false;
+        }
+        return ParseFixed(bid_price, price_decimals, ticker.bid_price) &&
+               ParseFixed(bid_quantity, quantity_decimals, ticker.bid_quantity) &&
+               ParseFixed(ask_price, price_decimals, ticker.ask_price) &&
+               ParseFixed(ask_quantity, quantity_decimals, ticker.ask_quantity);
+    }
+    
+    /**
+     * Parse a trade or aggTrade event into a TradeEvent with fixed-point
+     * price and quantity. Fails on any missing field or invalid number.
+     */
+    bool ParseTrade(simdjson::padded_string_view json,
+                    int price_decimals,
+                    int quantity_decimals,
+                    TradeEvent& trade) {
+        auto doc = parser_.iterate(json);
+        if (doc.error()) return false;
+        
+        // Get event type
+        auto event_result = doc["e"].get_string();
+        if (event_result.error()) return false;
+        std::string_view event_type = event_result.value();
+        trade.is_aggregate = (event_type == "aggTrade");
+        if (!trade.is_aggregate && event_type != "trade") return false;
+        
+        auto event_time_result = doc["E"].get_int64();
+        if (event_time_result.error()) return false;
+        trade.event_time = event_time_result.value();
+        
+        // Trade ID ("a" is the aggregate ID on aggTrade)
+        auto id_result = doc[trade.is_aggregate ? "a" : "t"].get_int64();
+        if (id_result.error()) return false;
+        trade.trade_id = id_result.value();
+        
+        // Price and quantity, converted from the raw token
+        std::string_view price;
+        std::string_view quantity;
+        if (!RawString(doc["p"], price) || !RawString(doc["q"], quantity)) return false;
+        if (!ParseFixed(price, price_decimals, trade.price) ||
+            !ParseFixed(quantity, quantity_decimals, trade.quantity)) {
+            return false;
+        }
+        
+        // Range of trades covered by an aggregate
+        trade.first_trade_id = trade.trade_id;
+        trade.last_trade_id = trade.trade_id;
+        if (trade.is_aggregate) {
+            auto first_result = doc["f"].get_int64();
+            auto last_result = doc["l"].get_int64();
+            if (first_result.error() || last_result.error()) return false;
+            trade.first_trade_id = first_result.value();
+            trade.last_trade_id = last_result.value();
+        }
+        
+        auto trade_time_result = doc["T"].get_int64();
+        if (trade_time_result.error()) return false;
+        trade.trade_time = trade_time_result.value();
+        
+        auto maker_result = doc["m"].get_bool();
+        if (maker_result.error()) return false;
+        trade.is_buyer_maker = maker_result.value();
+        
+        return true;
+    }
+    
+    // Parse depth snapshot from REST API
+    bool ParseDepthSnapshot(std::string_view json, DepthSnapshot& snapshot) {
+        snapshot.bids.clear();
+        snapshot.asks.clear();
+        return ParseSnapshot(Pad(json), snapshot.last_update_id,
+            [&](Side side, std::string_view price, std::string_view quantity) {
+                (side == Side::kBuy ? snapshot.bids : snapshot.asks)
+                    .emplace_back(std::string(price), std::string(quantity));
+            });
+    }
+    
+    /**
+     * Fused snapshot path, parsed in place: levels go straight to fixed
+     * point into the reused delta pools, with no string stage. Fails if
+     * any number is malformed or not representable at the given precision.
+     */
+    bool ParseDepthSnapshot(simdjson::padded_string_view json,
+                            int price_decimals,
+                            int quantity_decimals,
+                            DepthSnapshotDeltas& snapshot) {
+        bid_deltas_.clear();
+        ask_deltas_.clear();
+        bool numbers_valid = true;
+        bool ok = ParseSnapshot(json, snapshot.last_update_id,
+            [&](Side side, std::string_view price, std::string_view quantity) {
+                LevelDelta delta;
+                numbers_valid &= ParseFixed(price, price_decimals, delta.price) &&
+                                 ParseFixed(quantity, quantity_decimals, delta.quantity);
+                (side == Side::kBuy ? bid_deltas_ : ask_deltas_).push_back(delta);
+            });
+        snapshot.bids = bid_deltas_;
+        snapshot.asks = ask_deltas_;
+        return ok && numbers_valid;
+    }
+
+private:
+    static bool IsJsonSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+    
+    // Copy into a reused buffer with SIMDJSON_PADDING bytes of slack
+    simdjson::padded_string_view Pad(std::string_view json) {
+        input_.reserve(json.size() + simdjson::SIMDJSON_PADDING);
+        input_.assign(json.data(), json.size());
+        return simdjson::padded_string_view(input_.data(), input_.size(), input_.capacity());
+    }
+    
+    // Unquoted text of a JSON string token, pointing into the input buffer.
+    // Binance numeric strings never contain escapes.
+    static bool RawString(simdjson::simdjson_result<simdjson::ondemand::value> value,
+                          std::string_view& out) {
+        std::string_view token;
+        if (value.raw_json_token().get(token)) return false;
+        if (token.size() < 2 || token.front() != '"') return false;
+        token.remove_prefix(1);
+        size_t close = token.find('"');
+        if (close == std::string_view::npos) return false;
+        out = token.substr(0, close);
+        return true;
+    }
+    
+    // [["price","qty"], ...] -> on_level(price, qty) per well-formed entry
+    template <typename OnLevel>
+    static void ParseLevels(simdjson::ondemand::array levels, OnLevel&& on_level) {
+        for (auto level : levels) {
+            auto level_arr = level.get_array();
+            if (level_arr.error()) continue;
+            
+            std::string_view price;
+            std::string_view quantity;
+            auto it = level_arr.begin();
+            if (!RawString(*it, price)) continue;
+            ++it;
+            if (!RawString(*it, quantity)) continue;
+            on_level(price, quantity);
+        }
+    }
+    
+    // Shared snapshot walk: lastUpdateId into `last_update_id`, then every
+    // level to on_level(side, price, qty). A missing side is empty.
+    template <typename OnLevel>
+    bool ParseSnapshot(simdjson::padded_string_view json, int64_t& last_update_id,
+                       OnLevel&& on_level) {
+        auto doc = parser_.iterate(json);
+        if (doc.error()) return false;
+        
+        // Get last update ID
+        auto id_result = doc["lastUpdateId"].get_int64();
+        if (id_result.error()) return false;
+        last_update_id = id_result.value();
+        
+        // Parse bids
+        auto bids_result = doc["bids"].get_array();
+        if (!bids_result.error()) {
+            ParseLevels(bids_result.value(), [&](std::string_view price, std::string_view quantity) {
+                on_level(Side::kBuy, price, quantity);
+            });
+        }
+        
+        // Parse asks
+        auto asks_result = doc["asks"].get_array();
+        if (!asks_result.error()) {
+            ParseLevels(asks_result.value(), [&](std::string_view price, std::string_view quantity) {
+                on_level(Side::kSell, price, quantity);
+            });
+        }
+        
+        return true;
+    }
+    
+    // Shared depthUpdate walk: header fields into `update`, then every
+    // level to on_level(side, price, qty)
+    template <typename Update, typename OnLevel>
+    bool ParseDepth(simdjson::padded_string_view json, Update& update, OnLevel&& on_level) {
+        auto doc = parser_.iterate(json);
         if (doc.error()) return false;
         
         // Get event type
@@ -57,7 +529,7 @@ public:
         // Get symbol
         auto symbol_result = doc["s"].get_string();
         if (symbol_result.error()) return false;
-        update.symbol = std::string(symbol_result.value());
+        update.symbol = symbol_result.value();
         
         // Get update IDs
         auto first_id_result = doc["U"].get_int64();
@@ -69,113 +541,32 @@ public:
         update.final_update_id = final_id_result.value();
         
         // Parse bids
-        update.bids.clear();
         auto bids_result = doc["b"].get_array();
         if (!bids_result.error()) {
-            for (auto bid : bids_result.value()) {
-                auto bid_arr = bid.get_array();
-                if (bid_arr.error()) continue;
-                
-                auto it = bid_arr.begin();
-                auto price_result = (*it).get_string();
-                ++it;
-                auto qty_result = (*it).get_string();
-                
-                if (!price_result.error() && !qty_result.error()) {
-                    update.bids.emplace_back(
-                        std::string(price_result.value()),
-                        std::string(qty_result.value())
-                    );
-                }
-            }
+            ParseLevels(bids_result.value(), [&](std::string_view price, std::string_view qty) {
+                on_level(Side::kBuy, price, qty);
+            });
         }
         
         // Parse asks
-        update.asks.clear();
         auto asks_result = doc["a"].get_array();
         if (!asks_result.error()) {
-            for (auto ask : asks_result.value()) {
-                auto ask_arr = ask.get_array();
-                if (ask_arr.error()) continue;
-                
-                auto it = ask_arr.begin();
-                auto price_result = (*it).get_string();
-                ++it;
-                auto qty_result = (*it).get_string();
-                
-                if (!price_result.error() && !qty_result.error()) {
-                    update.asks.emplace_back(
-                        std::string(price_result.value()),
-                        std::string(qty_result.value())
-                    );
-                }
-            }
+            ParseLevels(asks_result.value(), [&](std::string_view price, std::string_view qty) {
+                on_level(Side::kSell, price, qty);
+            });
         }
         
         return true;
     }
     
-    // Parse depth snapshot from REST API
-    bool ParseDepthSnapshot(const std::string& json, DepthSnapshot& snapshot) {
-        padded_ = simdjson::padded_string(json);
-        auto doc = parser_.iterate(padded_);
-        if (doc.error()) return false;
-        
-        // Get last update ID
-        auto id_result = doc["lastUpdateId"].get_int64();
-        if (id_result.error()) return false;
-        snapshot.last_update_id = id_result.value();
-        
-        // Parse bids
-        snapshot.bids.clear();
-        auto bids_result = doc["bids"].get_array();
-        if (!bids_result.error()) {
-            for (auto bid : bids_result.value()) {
-                auto bid_arr = bid.get_array();
-                if (bid_arr.error()) continue;
-                
-                auto it = bid_arr.begin();
-                auto price_result = (*it).get_string();
-                ++it;
-                auto qty_result = (*it).get_string();
-                
-                if (!price_result.error() && !qty_result.error()) {
-                    snapshot.bids.emplace_back(
-                        std::string(price_result.value()),
-                        std::string(qty_result.value())
-                    );
-                }
-            }
-        }
-        
-        // Parse asks
-        snapshot.asks.clear();
-        auto asks_result = doc["asks"].get_array();
-        if (!asks_result.error()) {
-            for (auto ask : asks_result.value()) {
-                auto ask_arr = ask.get_array();
-                if (ask_arr.error()) continue;
-                
-                auto it = ask_arr.begin();
-                auto price_result = (*it).get_string();
-                ++it;
-                auto qty_result = (*it).get_string();
-                
-                if (!price_result.error() && !qty_result.error()) {
-                    snapshot.asks.emplace_back(
-                        std::string(price_result.value()),
-                        std::string(qty_result.value())
-                    );
-                }
-            }
-        }
-        
-        return true;
-    }
-
-private:
     simdjson::ondemand::parser parser_;
-    simdjson::padded_string padded_;
+    std::string input_;  // Padded copy for callers without padded buffers
+    
+    // Level pools reused between messages
+    std::vector<LevelView> bid_levels_;
+    std::vector<LevelView> ask_levels_;
+    std::vector<LevelDelta> bid_deltas_;
+    std::vector<LevelDelta> ask_deltas_;
 };
 
 }  // namespace hft
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "book_synchronizer.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace hft {
+
+BookSynchronizer::BookSynchronizer(BookManager& books,
+                                   SymbolId symbol_id,
+                                   SnapshotFetcher fetch,
+                                   size_t buffer_capacity)
+    : books_(books)
+    , symbol_id_(symbol_id)
+    , fetch_(std::move(fetch))
+    , price_decimals_(books.Book(symbol_id).GetPriceDecimals())
+    , quantity_decimals_(books.Book(symbol_id).GetQuantityDecimals())
+    , ring_(std::max<size_t>(buffer_capacity, 1)) {}
+
+// Cancel an in-flight fetch rather than wait out the network
+BookSynchronizer::~BookSynchronizer() {
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        stopping_ = true;
+    }
+    cancel_.store(true, std::memory_order_relaxed);
+    worker_cv_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool BookSynchronizer::OnDiff(const DepthDeltas& update) {
+    switch (state_) {
+        case State::kIdle:
+            Buffer(update);
+            state_ = State::kFetching;
+            StartFetch();
+            return false;
+            
+        case State::kFetching:
+        case State::kStale:
+            Buffer(update);
+            return Poll();
+            
+        case State::kLive:
+            break;
+    }
+    
+    switch (Apply(update.first_update_id, update.final_update_id, update.bids, update.asks)) {
+        case ApplyResult::kApplied:
+            return true;
+        case ApplyResult::kStale:
+            return false;
+        case ApplyResult::kOutOfSequence:
+        case ApplyResult::kGap:
+            MarkStale(update);
+            return false;
+    }
+    return false;
+}
+
+bool BookSynchronizer::Poll() {
+    if (state_ != State::kFetching && state_ != State::kStale) return false;
+    
+    switch (fetch_state_.load(std::memory_order_acquire)) {
+        case FetchState::kRunning:
+            return false;
+            
+        case FetchState::kNone:
+            if (NowNanos() >= retry_after_) StartFetch();
+            return false;
+            
+        case FetchState::kFailed:
+            last_error_ = fetch_error_;
+            ++fetch_failures_;
+            fetch_state_.store(FetchState::kNone, std::memory_order_relaxed);
+            retry_after_ = NowNanos() + kRetryDelayNanos;
+            return false;
+            
+        case FetchState::kReady:
+            fetch_state_.store(FetchState::kNone, std::memory_order_relaxed);
+            return CompleteSync();
+    }
+    return false;
+}
+
+void BookSynchronizer::Buffer(const DepthDeltas& update) {
+    size_t capacity = ring_.size();
+    if (ring_size_ == capacity) {
+        // Drop the oldest; replay then finds the hole and refetches
+        ring_head_ = (ring_head_ + 1) % capacity;
+        --ring_size_;
+        ++buffer_overflows_;
+    }
+    
+    BufferedDiff& slot = ring_[(ring_head_ + ring_size_) % capacity];
+    slot.first_update_id = update.first_update_id;
+    slot.final_update_id = update.final_update_id;
+    slot.bids.assign(update.bids.begin(), update.bids.end());
+    slot.asks.assign(update.asks.begin(), update.asks.end());
+    ++ring_size_;
+}
+
+// Hand the worker a request; it is idle whenever fetch_state_ is not kRunning
+void BookSynchronizer::StartFetch() {
+    fetch_state_.store(FetchState::kRunning, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        fetch_requested_ = true;
+    }
+    if (!worker_.joinable()) {
+        worker_ = std::thread([this]() { RunWorker(); });
+    } else {
+        worker_cv_.notify_one();
+    }
+}
+
+// Book no longer matches the exchange: resync, keeping the diff that showed it
+void BookSynchronizer::MarkStale(const DepthDeltas& update) {
+    state_ = State::kStale;
+    stale_since_ = NowNanos();
+    if (stale_since_ - live_since_ >= kMaxRefetchDelayNanos) {
+        refetch_delay_ = 0;
+    }
+    Buffer(update);
+    ScheduleRefetch();
+}
+
+// Fetch again once the backoff allows; Poll() starts it if it cannot go now
+void BookSynchronizer::ScheduleRefetch() {
+    ++refetches_;
+    Timestamp now = NowNanos();
+    retry_after_ = std::max(retry_after_, now + refetch_delay_);
+    refetch_delay_ = std::clamp(refetch_delay_ * 2, kRefetchDelayNanos, kMaxRefetchDelayNanos);
+    if (now >= retry_after_) StartFetch();
+}
+
+void BookSynchronizer::RunWorker() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(worker_mutex_);
+            worker_cv_.wait(lock, [this]() { return fetch_requested_ || stopping_; });
+            if (stopping_) return;
+            fetch_requested_ = false;
+        }
+        RunFetch();
+    }
+}
+
+// Worker thread: download and decode; the writer thread picks the result up
+// through fetch_state_.
+void BookSynchronizer::RunFetch() {
+    FetchState result = FetchState::kFailed;
+    try {
+        std::string body = fetch_(cancel_);
+        size_t size = body.size();
+        body.reserve(size + simdjson::SIMDJSON_PADDING);
+        if (decoder_.Decode(simdjson::padded_string_view(body.data(), size, body.capacity()),
+                                    price_decimals_, quantity_decimals_, snapshot_)) {
+            result = FetchState::kReady;
+        } else {
+            fetch_error_ = "invalid snapshot";
+        }
+    } catch (const std::exception& e) {
+        fetch_error_ = e.what();
+    }
+    
+    if (cancel_.load(std::memory_order_relaxed)) return;  // Tearing down
+    fetch_state_.store(result, std::memory_order_release);
+    if (on_ready_) {
+        on_ready_();
+    }
+}
+
+bool BookSynchronizer::CompleteSync() {
+    books_.LoadSnapshot(symbol_id_, snapshot_.bids, snapshot_.asks, snapshot_.last_update_id);
+    last_update_id_ = snapshot_.last_update_id;
+    awaiting_first_ = true;
+    ++snapshots_loaded_;
+    
+    for (; ring_size_ > 0; --ring_size_, ring_head_ = (ring_head_ + 1) % ring_.size()) {
+        const BufferedDiff& diff = ring_[ring_head_];
+        ApplyResult result = Apply(diff.first_update_id, diff.final_update_id, diff.bids, diff.asks);
+        if (result == ApplyResult::kOutOfSequence || result == ApplyResult::kGap) {
+            // Snapshot predates the buffer, or the buffer has a hole:
+            // keep the rest and try a newer snapshot
+            ScheduleRefetch();
+            return false;
+        }
+        if (result == ApplyResult::kApplied) ++diffs_replayed_;
+    }
+    
+    if (state_ == State::kStale) {
+        last_resync_nanos_ = NowNanos() - stale_since_;
+        resync_stats_.Record(last_resync_nanos_);
+    }
+    state_ = State::kLive;
+    live_since_ = NowNanos();
+    return true;
+}
+
+BookSynchronizer::ApplyResult BookSynchronizer::Apply(int64_t first_update_id,
+                                                      int64_t final_update_id,
+                                                      std::span<const LevelDelta> bids,
+                                                      std::span<const LevelDelta> asks) {
+    if (final_update_id <= last_update_id_) {
+        ++diffs_stale_;
+        return ApplyResult::kStale;
+    }
+    if (awaiting_first_) {
+        if (first_update_id > last_update_id_ + 1) return ApplyResult::kOutOfSequence;
+    } else if (first_update_id != last_update_id_ + 1) {
+        ++gaps_;
+        if (first_update_id > last_update_id_ + 1) {
+            missed_updates_ += static_cast<uint64_t>(first_update_id - last_update_id_ - 1);
+        }
+        return ApplyResult::kGap;
+    }
+    awaiting_first_ = false;
+    
+    books_.Book(symbol_id_).SetLastUpdateId(final_update_id);
+    books_.ApplyBatch(symbol_id_, bids, asks);
+    last_update_id_ = final_update_id;
+    return ApplyResult::kApplied;
+}
+
+}  // namespace hft
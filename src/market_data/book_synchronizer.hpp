@@ -0,0 +1,199 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "binance_messages.hpp"
+#include "book_manager.hpp"
+#include "depth_decoder.hpp"
+#include "latency_histogram.hpp"
+#include "types.hpp"
+
+namespace hft {
+
+/**
+ * Keeps one symbol's book in step with Binance's diff stream without
+ * blocking the thread that writes the book.
+ *
+ * The first diff starts a REST snapshot fetch on the synchronizer's worker
+ * thread, which is started once and then waits for the next request. Diffs
+ * keep arriving meanwhile and are copied into a ring. Once the snapshot
+ * is decoded, the writer thread loads it into the book, drops buffered diffs
+ * with u <= lastUpdateId, checks that the first remaining one satisfies
+ * U <= lastUpdateId + 1 <= u, and replays the rest. If it does not (the
+ * ring overflowed, or the snapshot is older than the buffer), a new
+ * snapshot is fetched while buffering continues.
+ *
+ * Once live, every diff must continue the previous one (U == last u + 1).
+ * A gap marks the book stale and starts the same fetch/buffer/replay cycle
+ * in place: the connection and the other symbols are not touched.
+ *
+ * Snapshots are heavy on the REST rate limit, which is shared by every
+ * symbol on the IP. The first refetch after a healthy live period goes
+ * out at once; each further one in a row, from a gap or a snapshot that
+ * does not bridge the buffer, waits twice as long as the last, from
+ * kRefetchDelayNanos up to kMaxRefetchDelayNanos.
+ *
+ * All methods except the fetcher and the ready callback run on the book's
+ * writer thread. In binance_stream that is the book-stage consumer of the
+ * event ring, not the I/O thread: OnDiff() is called for each kDepth event
+ * and Poll() for each kSnapshotReady.
+ */
+class BookSynchronizer {
+public:
+    enum class State : uint8_t {
+        kIdle,      // No diff seen yet
+        kFetching,  // Snapshot in flight, diffs buffering
+        kLive,      // Book synchronized, diffs applied as they arrive
+        kStale      // Gap seen: book out of date until the resync completes
+    };
+
+    // Returns the raw REST depth JSON; runs on the worker thread, may
+    // throw. Should give up promptly once `cancel` is set: the destructor
+    // sets it and then joins the worker.
+    using SnapshotFetcher = std::function<std::string(const std::atomic<bool>& cancel)>;
+
+    // Called on the worker thread once a snapshot is ready (or failed),
+    // e.g. to get Poll() run on the writer thread
+    using ReadyCallback = std::function<void()>;
+
+    static constexpr size_t kDefaultBufferCapacity = 1024;
+
+    // Wait after a failed fetch before trying again
+    static constexpr Timestamp kRetryDelayNanos = 1'000'000'000;
+
+    // Refetch backoff; live this long and the next refetch is immediate again
+    static constexpr Timestamp kRefetchDelayNanos = 1'000'000'000;
+    static constexpr Timestamp kMaxRefetchDelayNanos = 60'000'000'000;
+
+    BookSynchronizer(BookManager& books,
+                     SymbolId symbol_id,
+                     SnapshotFetcher fetch,
+                     size_t buffer_capacity = kDefaultBufferCapacity);
+    ~BookSynchronizer();
+
+    BookSynchronizer(const BookSynchronizer&) = delete;
+    BookSynchronizer& operator=(const BookSynchronizer&) = delete;
+
+    void SetOnReady(ReadyCallback callback) { on_ready_ = std::move(callback); }
+
+    /**
+     * Feed one diff of this symbol. Returns true if the book changed:
+     * the diff was applied live, or a snapshot was loaded and replayed.
+     * Returns false for a diff that reveals a gap (the book is then stale).
+     */
+    bool OnDiff(const DepthDeltas& update);
+
+    /**
+     * Finish a sync if the snapshot has arrived; returns true if the book
+     * changed. OnDiff() already does this; call it from the ready
+     * callback's posted task to sync without waiting for the next diff.
+     */
+    bool Poll();
+
+    State GetState() const { return state_; }
+    bool IsLive() const { return state_ == State::kLive; }
+    bool IsStale() const { return state_ == State::kStale; }
+    SymbolId GetSymbolId() const { return symbol_id_; }
+    int64_t GetLastUpdateId() const { return last_update_id_; }
+
+    // === Statistics ===
+
+    uint64_t GetSnapshotCount() const { return snapshots_loaded_; }
+    uint64_t GetFetchFailureCount() const { return fetch_failures_; }
+    uint64_t GetRefetchCount() const { return refetches_; }  // After a gap or unbridged snapshot
+    uint64_t GetReplayedCount() const { return diffs_replayed_; }
+    uint64_t GetStaleDroppedCount() const { return diffs_stale_; }
+    uint64_t GetOverflowCount() const { return buffer_overflows_; }
+    
+    // Discontinuities in the diff stream, and update ids they skipped
+    uint64_t GetGapCount() const { return gaps_; }
+    uint64_t GetMissedUpdateCount() const { return missed_updates_; }
+    
+    // Time from a gap to the book being live again, per resync
+    const LatencyHistogram& GetResyncStats() const { return resync_stats_; }
+    Timestamp GetLastResyncNanos() const { return last_resync_nanos_; }
+
+    // Reason for the last failed fetch; valid once it has been counted
+    const std::string& GetLastError() const { return last_error_; }
+
+private:
+    enum class FetchState : uint8_t { kNone, kRunning, kReady, kFailed };
+    enum class ApplyResult : uint8_t {
+        kApplied,
+        kStale,          // Already in the book
+        kOutOfSequence,  // First diff after a snapshot does not bridge it
+        kGap             // Does not continue the previous diff
+    };
+
+    // Owned copy of a diff; vectors keep their capacity across reuse
+    struct BufferedDiff {
+        int64_t first_update_id = 0;
+        int64_t final_update_id = 0;
+        std::vector<LevelDelta> bids;
+        std::vector<LevelDelta> asks;
+    };
+
+    void Buffer(const DepthDeltas& update);
+    void StartFetch();
+    void MarkStale(const DepthDeltas& update);
+    void ScheduleRefetch();
+    void RunWorker();
+    void RunFetch();
+    bool CompleteSync();
+
+    ApplyResult Apply(int64_t first_update_id, int64_t final_update_id,
+                      std::span<const LevelDelta> bids, std::span<const LevelDelta> asks);
+
+    BookManager& books_;
+    SymbolId symbol_id_;
+    SnapshotFetcher fetch_;
+    ReadyCallback on_ready_;
+    int price_decimals_;
+    int quantity_decimals_;
+
+    State state_ = State::kIdle;
+    int64_t last_update_id_ = 0;
+    bool awaiting_first_ = false;  // Next diff is the first after a snapshot
+    Timestamp retry_after_ = 0;
+    Timestamp refetch_delay_ = 0;  // Backoff for the next refetch in a row
+    Timestamp live_since_ = 0;
+    Timestamp stale_since_ = 0;
+
+    // Ring of diffs received while fetching
+    std::vector<BufferedDiff> ring_;
+    size_t ring_head_ = 0;
+    size_t ring_size_ = 0;
+
+    // Worker side; snapshot_ and fetch_error_ are handed over by
+    // fetch_state_ (release/acquire)
+    std::thread worker_;  // Started by the first fetch
+    std::mutex worker_mutex_;
+    std::condition_variable worker_cv_;
+    bool fetch_requested_ = false;  // Guarded by worker_mutex_
+    bool stopping_ = false;         // Guarded by worker_mutex_
+    std::atomic<bool> cancel_{false};
+    std::atomic<FetchState> fetch_state_{FetchState::kNone};
+    DepthSnapshotDecoder decoder_;
+    DepthSnapshotDeltas snapshot_;
+    std::string fetch_error_;
+    std::string last_error_;
+
+    uint64_t snapshots_loaded_ = 0;
+    uint64_t fetch_failures_ = 0;
+    uint64_t refetches_ = 0;
+    uint64_t diffs_replayed_ = 0;
+    uint64_t diffs_stale_ = 0;
+    uint64_t buffer_overflows_ = 0;
+    uint64_t gaps_ = 0;
+    uint64_t missed_updates_ = 0;
+    LatencyHistogram resync_stats_{"Resync"};
+    Timestamp last_resync_nanos_ = 0;
+};
+
+}  // namespace hft
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include "binance_messages.hpp"
+#include "fixed_point.hpp"
+#include "types.hpp"
+
+namespace hft {
+
+/**
+ * Forward-only reader over compact JSON with a known layout, used by the
+ * schema-specific decoders below. Every method returns false on mismatch.
+ */
+struct JsonCursor {
+    const char* p;
+    const char* end;
+
+    template <size_t N>
+    bool Expect(const char (&literal)[N]) {
+        constexpr size_t kLength = N - 1;
+        if (static_cast<size_t>(end - p) < kLength ||
+            std::memcmp(p, literal, kLength) != 0) {
+            return false;
+        }
+        p += kLength;
+        return true;
+    }
+
+    bool Integer(int64_t& value) {
+        const char* start = p;
+        while (p != end && *p >= '0' && *p <= '9') ++p;
+        return p != start && ParseFixed(std::string_view(start, static_cast<size_t>(p - start)),
+                                        0, value);
+    }
+
+    // Quoted string without escapes
+    bool String(std::string_view& value) {
+        if (p == end || *p != '"') return false;
+        const char* start = ++p;
+        const char* close = static_cast<const char*>(
+            std::memchr(start, '"', static_cast<size_t>(end - start)));
+        if (close == nullptr) return false;
+        value = std::string_view(start, static_cast<size_t>(close - start));
+        if (value.find('\\') != std::string_view::npos) return false;
+        p = close + 1;
+        return true;
+    }
+
+    // Quoted decimal straight to fixed point
+    bool Fixed(int decimals, int64_t& value) {
+        std::string_view text;
+        return String(text) && ParseFixed(text, decimals, value);
+    }
+};
+
+/**
+ * Schema-specific decoder for Binance REST depth snapshots:
+ *   {"lastUpdateId":..,"bids":[["price","qty"],..],"asks":[..]}
+ * The fast path walks that layout with a cursor, comparing the literal
+ * key sequence and converting each level straight to fixed point; there
+ * is no structural index and no key lookup. Anything it does not
+ * recognise (other key order, whitespace, escapes, extra fields) falls
+ * back to FastJsonParser, so the output is the same as the generic
+ * parser's for any input.
+ */
+class DepthSnapshotDecoder {
+public:
+    /**
+     * Fast path then fallback. Output arrays point into this decoder's
+     * pools, or into the fallback parser's, until the next Decode call.
+     */
+    bool Decode(simdjson::padded_string_view json,
+                int price_decimals,
+                int quantity_decimals,
+                DepthSnapshotDeltas& snapshot) {
+        if (TryDecode(json, price_decimals, quantity_decimals, snapshot)) {
+            ++fast_path_count_;
+            return true;
+        }
+        ++fallback_count_;
+        return fallback_.ParseDepthSnapshot(json, price_decimals, quantity_decimals, snapshot);
+    }
+
+    /**
+     * Fast path only. Returns false if the body deviates from the
+     * expected layout or holds an invalid number.
+     */
+    bool TryDecode(std::string_view json,
+                   int price_decimals,
+                   int quantity_decimals,
+                   DepthSnapshotDeltas& snapshot) {
+        JsonCursor c{json.data(), json.data() + json.size()};
+
+        if (!c.Expect(R"({"lastUpdateId":)") || !c.Integer(snapshot.last_update_id)) return false;
+        if (!c.Expect(R"(,"bids":)") ||
+            !Levels(c, price_decimals, quantity_decimals, bid_deltas_)) {
+            return false;
+        }
+        if (!c.Expect(R"(,"asks":)") ||
+            !Levels(c, price_decimals, quantity_decimals, ask_deltas_)) {
+            return false;
+        }
+        if (!c.Expect("}") || c.p != c.end) return false;
+
+        snapshot.bids = bid_deltas_;
+        snapshot.asks = ask_deltas_;
+        return true;
+    }
+
+    // Size the level pools up front, e.g. to the snapshot depth limit
+    void Reserve(size_t levels_per_side) {
+        bid_deltas_.reserve(levels_per_side);
+        ask_deltas_.reserve(levels_per_side);
+    }
+
+    // Messages decoded by the fast path and by the fallback parser
+    uint64_t GetFastPathCount() const { return fast_path_count_; }
+    uint64_t GetFallbackCount() const { return fallback_count_; }
+
+private:
+    // [["price","qty"],...] straight into fixed-point deltas
+    static bool Levels(JsonCursor& c, int price_decimals, int quantity_decimals,
+                       std::vector<LevelDelta>& out) {
+        out.clear();
+        if (!c.Expect("[")) return false;
+        if (c.Expect("]")) return true;
+
+        do {
+            std::string_view price;
+            std::string_view quantity;
+            LevelDelta delta;
+            if (!c.Expect("[") || !c.String(price) || !c.Expect(",") ||
+                !c.String(quantity) || !c.Expect("]")) {
+                return false;
+            }
+            if (!ParseFixed(price, price_decimals, delta.price) ||
+                !ParseFixed(quantity, quantity_decimals, delta.quantity)) {
+                return false;
+            }
+            out.push_back(delta);
+        } while (c.Expect(","));
+
+        return c.Expect("]");
+    }
+
+    std::vector<LevelDelta> bid_deltas_;
+    std::vector<LevelDelta> ask_deltas_;
+    FastJsonParser fallback_;
+
+    uint64_t fast_path_count_ = 0;
+    uint64_t fallback_count_ = 0;
+};
+
+/**
+ * Schema-specific decoder for spot bookTicker messages:
+ *   {"u":..,"s":"..","b":"..","B":"..","a":"..","A":".."}
+ * Same contract as DepthSnapshotDecoder: any other layout falls back to
+ * FastJsonParser, which also covers the futures form with "e" and "E".
+ */
+class BookTickerDecoder {
+public:
+    bool Decode(simdjson::padded_string_view json,
+                int price_decimals,
+                int quantity_decimals,
+                BookTicker& ticker) {
+        if (TryDecode(json, price_decimals, quantity_decimals, ticker)) {
+            ++fast_path_count_;
+            return true;
+        }
+        ++fallback_count_;
+        return fallback_.ParseBookTicker(json, price_decimals, quantity_decimals, ticker);
+    }
+
+    bool TryDecode(std::string_view json,
+                   int price_decimals,
+                   int quantity_decimals,
+                   BookTicker& ticker) const {
+        JsonCursor c{json.data(), json.data() + json.size()};
+        std::string_view symbol;
+        return c.Expect(R"({"u":)") && c.Integer(ticker.update_id) &&
+               c.Expect(R"(,"s":)") && c.String(symbol) &&
+               c.Expect(R"(,"b":)") && c.Fixed(price_decimals, ticker.bid_price) &&
+               c.Expect(R"(,"B":)") && c.Fixed(quantity_decimals, ticker.bid_quantity) &&
+               c.Expect(R"(,"a":)") && c.Fixed(price_decimals, ticker.ask_price) &&
+               c.Expect(R"(,"A":)") && c.Fixed(quantity_decimals, ticker.ask_quantity) &&
+               c.Expect("}") && c.p == c.end;
+    }
+
+    uint64_t GetFastPathCount() const { return fast_path_count_; }
+    uint64_t GetFallbackCount() const { return fallback_count_; }
+
+private:
+    FastJsonParser fallback_;
+
+    uint64_t fast_path_count_ = 0;
+    uint64_t fallback_count_ = 0;
+};
+
+}  // namespace hft
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "binance_messages.hpp"
+#include "latency_histogram.hpp"
+#include "types.hpp"
+
+namespace hft {
+
+/**
+ * First-arrival arbitration between redundant copies of the same streams
+ * (A/B feed legs).
+ *
+ * Every event is keyed by (stream kind, symbol, id), where the id is the
+ * depthUpdate/bookTicker final update id or the trade/aggTrade id. Ids
+ * only grow within a key, so the first copy with an id above the last
+ * delivered one wins and every later copy is a duplicate. An older copy
+ * that was never delivered is dropped too: the consumer has already moved
+ * past it.
+ *
+ * Per leg it counts messages, wins and duplicates, and records each
+ * duplicate's lag behind the winning copy into a fixed-size histogram, so
+ * arbitration never locks or allocates. Single-threaded: call it from the
+ * I/O thread that runs all legs. The lag histograms may be read from any
+ * thread; the counters only once the legs are stopped.
+ */
+class FeedArbiter {
+public:
+    struct LegStats {
+        uint64_t messages = 0;
+        uint64_t wins = 0;        // Delivered: this leg's copy came first
+        uint64_t duplicates = 0;  // Another leg had already delivered it
+        LatencyHistogram lag{"Leg lag"};  // Duplicate arrival - winner arrival
+
+        double WinRate() const {
+            return messages > 0 ? static_cast<double>(wins) / messages : 0.0;
+        }
+    };
+
+    explicit FeedArbiter(size_t leg_count = 2) { Reset(leg_count); }
+
+    // Forget all keys and statistics
+    void Reset(size_t leg_count) {
+        keys_.clear();
+        legs_.clear();
+        for (size_t i = 0; i < leg_count; ++i) {
+            legs_.emplace_back();
+        }
+    }
+
+    /**
+     * True if this copy is the first of its key and should be delivered.
+     */
+    bool Accept(EventType type, SymbolId symbol_id, int64_t id, size_t leg, Timestamp now) {
+        Key& key = KeyOf(type, symbol_id);
+        LegStats& stats = legs_[leg];
+        ++stats.messages;
+
+        if (id > key.last_id) {
+            key.last_id = id;
+            key.recent[key.next++ % kRecent] = Arrival{id, now};
+            ++stats.wins;
+            return true;
+        }
+
+        ++stats.duplicates;
+        for (const Arrival& arrival : key.recent) {
+            if (arrival.id == id) {
+                stats.lag.Record(now - arrival.time);
+                break;
+            }
+        }
+        return false;
+    }
+
+    size_t GetLegCount() const { return legs_.size(); }
+    const LegStats& GetLegStats(size_t leg) const { return legs_[leg]; }
+
+private:
+    // Winners remembered per key for lag measurement; a leg further
+    // behind than this still counts duplicates, without a lag sample
+    static constexpr size_t kRecent = 16;
+    static constexpr size_t kKinds = 4;  // EventType minus kUnknown
+
+    struct Arrival {
+        int64_t id = -1;
+        Timestamp time = 0;
+    };
+
+    struct Key {
+        int64_t last_id = -1;
+        std::array<Arrival, kRecent> recent;
+        size_t next = 0;
+    };
+
+    Key& KeyOf(EventType type, SymbolId symbol_id) {
+        size_t index = static_cast<size_t>(symbol_id) * kKinds + static_cast<size_t>(type) - 1;
+        if (index >= keys_.size()) {
+            keys_.resize((static_cast<size_t>(symbol_id) + 1) * kKinds);
+        }
+        return keys_[index];
+    }
+
+    std::vector<Key> keys_;        // [symbol_id * kKinds + kind]
+    std::deque<LegStats> legs_;    // Deque: LatencyHistogram is not movable
+};
+
+}  // namespace hft
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+#include "binance_messages.hpp"
+#include "types.hpp"
+
+namespace hft {
+
+/**
+ * Owned, fixed-point copy of one feed event, for handing events from the
+ * I/O thread to other threads (e.g. as a RingBuffer slot).
+ *
+ * Client callbacks only lend their level arrays for the duration of the
+ * call; the Assign methods copy them into vectors that keep their
+ * capacity, so a reused event stops allocating once it has seen the
+ * largest message.
+ */
+struct FeedEvent {
+    enum class Kind : uint8_t {
+        kDepth,
+        kBookTicker,
+        kTrade,
+        kSnapshotReady  // A BookSynchronizer fetch finished: Poll() it
+    };
+
+    Kind kind = Kind::kDepth;
+    SymbolId symbol_id = 0;
+    Timestamp received = 0;  // NowNanos() on the I/O thread
+
+    // kDepth
+    int64_t first_update_id = 0;
+    int64_t final_update_id = 0;
+    std::vector<LevelDelta> bids;
+    std::vector<LevelDelta> asks;
+
+    BookTicker ticker;  // kBookTicker
+    TradeEvent trade;   // kTrade
+
+    void AssignDepth(const DepthDeltas& update, Timestamp now) {
+        kind = Kind::kDepth;
+        symbol_id = update.symbol_id;
+        received = now;
+        first_update_id = update.first_update_id;
+        final_update_id = update.final_update_id;
+        bids.assign(update.bids.begin(), update.bids.end());
+        asks.assign(update.asks.begin(), update.asks.end());
+    }
+
+    void AssignTicker(const BookTicker& quote, Timestamp now) {
+        kind = Kind::kBookTicker;
+        symbol_id = quote.symbol_id;
+        received = now;
+        ticker = quote;
+    }
+
+    void AssignTrade(const TradeEvent& event, Timestamp now) {
+        kind = Kind::kTrade;
+        symbol_id = event.symbol_id;
+        received = now;
+        trade = event;
+    }
+
+    void AssignSnapshotReady(SymbolId id, Timestamp now) {
+        kind = Kind::kSnapshotReady;
+        symbol_id = id;
+        received = now;
+    }
+
+    // kDepth as the client hands it out; valid while the event is
+    DepthDeltas Depth() const {
+        DepthDeltas update;
+        update.symbol_id = symbol_id;
+        update.first_update_id = first_update_id;
+        update.final_update_id = final_update_id;
+        update.bids = bids;
+        update.asks = asks;
+        return update;
+    }
+};
+
+}  // namespace hft
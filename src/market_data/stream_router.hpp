@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Perfect hash from a fixed set of keys (stream symbols) to their index.
+ *
+ * Hash-and-displace: the key hash picks a bucket, and the bucket's pilot
+ * value (found by Build()) remaps the same hash to a slot no other key
+ * occupies. Find() is one pass over the key, an integer mix, a mask and
+ * one equality check against the slot's key, with no probing or chaining.
+ * Built once at subscribe time; Find() is read-only and allocation-free.
+ */
+class StreamRouter {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    /**
+     * Index i maps keys[i] -> i. Keys must be distinct.
+     */
+    void Build(const std::vector<std::string>& keys) {
+        size_t table_size = std::bit_ceil(std::max<size_t>(2 * keys.size(), 1));
+        size_t bucket_count = std::bit_ceil(std::max<size_t>(keys.size() / 2, 1));
+        for (;;) {
+            for (uint64_t seed = 1; seed <= kMaxSeedTries; ++seed) {
+                if (TryBuild(keys, seed, table_size, bucket_count)) return;
+            }
+            table_size *= 2;  // Unlucky key set: retry with more room
+        }
+    }
+
+    /**
+     * Index of `key`, or kNotFound for keys outside the set.
+     */
+    uint32_t Find(std::string_view key) const {
+        if (slot_values_.empty()) return kNotFound;
+        uint64_t h = Hash(key, seed_);
+        size_t slot = Slot(h, pilots_[(h >> 32) & bucket_mask_]) & mask_;
+        return slot_keys_[slot] == key ? slot_values_[slot] : kNotFound;
+    }
+
+    uint64_t GetSeed() const { return seed_; }
+    size_t GetTableSize() const { return slot_values_.size(); }
+
+    /**
+     * Seeded hash over 8-byte words of the key.
+     */
+    static uint64_t Hash(std::string_view key, uint64_t seed) {
+        constexpr uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+        uint64_t h = seed ^ (key.size() * kMul);
+        const char* p = key.data();
+        size_t n = key.size();
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            h = (h ^ word) * kMul;
+            h ^= h >> 29;
+        }
+        if (n > 0) {
+            uint64_t word = 0;
+            std::memcpy(&word, p, n);
+            h = (h ^ word) * kMul;
+            h ^= h >> 29;
+        }
+        return h ^ (h >> 32);
+    }
+
+private:
+    static constexpr uint64_t kMaxSeedTries = 64;
+    static constexpr uint32_t kMaxPilot = 1 << 16;
+
+    // Slot of hash h under a bucket's pilot, before masking
+    static uint64_t Slot(uint64_t h, uint32_t pilot) {
+        uint64_t x = h ^ (pilot * 0xC2B2AE3D27D4EB4FULL);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        return x ^ (x >> 33);
+    }
+
+    bool TryBuild(const std::vector<std::string>& keys, uint64_t seed,
+                  size_t table_size, size_t bucket_count) {
+        size_t bucket_mask = bucket_count - 1;
+        size_t mask = table_size - 1;
+
+        std::vector<uint64_t> hashes(keys.size());
+        std::vector<std::vector<uint32_t>> buckets(bucket_count);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            hashes[i] = Hash(keys[i], seed);
+            buckets[(hashes[i] >> 32) & bucket_mask].push_back(static_cast<uint32_t>(i));
+        }
+
+        // Largest buckets first, while the table is still mostly free
+        std::vector<uint32_t> order(bucket_count);
+        for (size_t b = 0; b < bucket_count; ++b) order[b] = static_cast<uint32_t>(b);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        std::vector<uint32_t> values(table_size, kNotFound);
+        std::vector<uint32_t> pilots(bucket_count, 0);
+        std::vector<size_t> slots;
+        for (uint32_t b : order) {
+            const auto& bucket = buckets[b];
+            if (bucket.empty()) break;
+
+            bool placed = false;
+            for (uint32_t pilot = 0; pilot < kMaxPilot && !placed; ++pilot) {
+                slots.clear();
+                placed = true;
+                for (uint32_t key : bucket) {
+                    size_t slot = Slot(hashes[key], pilot) & mask;
+                    if (values[slot] != kNotFound ||
+                        std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        placed = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (placed) {
+                    for (size_t k = 0; k < bucket.size(); ++k) values[slots[k]] = bucket[k];
+                    pilots[b] = pilot;
+                }
+            }
+            if (!placed) return false;  // Keys with equal hashes, or just unlucky
+        }
+
+        slot_keys_.assign(table_size, std::string());
+        for (size_t slot = 0; slot < table_size; ++slot) {
+            if (values[slot] != kNotFound) slot_keys_[slot] = keys[values[slot]];
+        }
+        slot_values_ = std::move(values);
+        pilots_ = std::move(pilots);
+        seed_ = seed;
+        mask_ = mask;
+        bucket_mask_ = bucket_mask;
+        return true;
+    }
+
+    std::vector<std::string> slot_keys_;  // Empty for unused slots
+    std::vector<uint32_t> slot_values_;
+    std::vector<uint32_t> pilots_;        // Per-bucket displacement
+    uint64_t seed_ = 0;
+    size_t mask_ = 0;
+    size_t bucket_mask_ = 0;
+};
+
+}  // namespace hft
@@ -0,0 +1,93 @@
+#include "book_manager.hpp"
+#include <cctype>
+
+namespace hft {
+
+BookManager::BookManager(size_t tracked_depth)
+    : tracked_depth_(tracked_depth) {}
+
+std::string BookManager::Normalize(std::string_view symbol) {
+    std::string upper(symbol);
+    for (char& c : upper) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return upper;
+}
+
+SymbolId BookManager::AddSymbol(std::string_view symbol,
+                                int price_decimals,
+                                int quantity_decimals,
+                                Price tick_size,
+                                size_t ladder_ticks) {
+    std::string name = Normalize(symbol);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) return it->second;
+
+    SymbolId id = static_cast<SymbolId>(books_.size());
+    auto book = std::make_unique<OrderBook>(name, price_decimals, quantity_decimals,
+                                            tick_size, ladder_ticks);
+    book->TrackDepth(tracked_depth_);
+
+    books_.push_back(std::move(book));
+    symbols_.push_back(name);
+    ids_.emplace(std::move(name), id);
+
+    best_bids_.push_back(kNoPrice);
+    best_asks_.push_back(kNoPrice);
+    bid_depth_qty_.push_back(0);
+    ask_depth_qty_.push_back(0);
+    return id;
+}
+
+std::optional<SymbolId> BookManager::FindSymbol(std::string_view symbol) const {
+    auto it = ids_.find(Normalize(symbol));
+    if (it == ids_.end()) return std::nullopt;
+    return it->second;
+}
+
+BatchResult BookManager::ApplyBatch(SymbolId id,
+                                    std::span<const LevelDelta> bids,
+                                    std::span<const LevelDelta> asks) {
+    BatchResult result = books_[id]->ApplyBatch(bids, asks);
+    // best_*_changed covers the price arrays when tracked_depth_ is 0
+    if (result.best_bid_changed || result.best_ask_changed ||
+        result.TopChanged(Side::kBuy, tracked_depth_) ||
+        result.TopChanged(Side::kSell, tracked_depth_)) {
+        RefreshTop(id);
+    }
+    return result;
+}
+
+bool BookManager::ApplyTicker(SymbolId id, const TopOfBook& quote) {
+    if (!books_[id]->ApplyTicker(quote)) return false;
+    RefreshTop(id);
+    return true;
+}
+
+void BookManager::LoadSnapshot(SymbolId id,
+                               std::span<const LevelDelta> bids,
+                               std::span<const LevelDelta> asks,
+                               int64_t last_update_id) {
+    books_[id]->LoadSnapshot(bids, asks, last_update_id);
+    RefreshTop(id);
+}
+
+void BookManager::Update(SymbolId id, Side side, Price price, Quantity quantity) {
+    books_[id]->Update(side, price, quantity);
+    RefreshTop(id);
+}
+
+void BookManager::Clear(SymbolId id) {
+    books_[id]->Clear();
+    RefreshTop(id);
+}
+
+void BookManager::RefreshTop(SymbolId id) {
+    const OrderBook& book = *books_[id];
+    best_bids_[id] = book.GetBestBid().value_or(kNoPrice);
+    best_asks_[id] = book.GetBestAsk().value_or(kNoPrice);
+    bid_depth_qty_[id] = book.GetDepthQuantity(Side::kBuy, tracked_depth_);
+    ask_depth_qty_[id] = book.GetDepthQuantity(Side::kSell, tracked_depth_);
+}
+
+}  // namespace hft
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "types.hpp"
+#include "order_book.hpp"
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Owns one OrderBook per symbol and routes updates by dense SymbolId.
+ *
+ * Symbols are interned to consecutive ids when they are added (subscribe
+ * time); the only string lookup happens there. After every routed update
+ * the manager refreshes that symbol's row in structure-of-arrays form
+ * (best bid, best ask, top-N bid/ask quantity), so scans across all
+ * symbols are linear walks over contiguous arrays.
+ *
+ * Not thread-safe: add symbols before streaming starts and apply updates
+ * from one thread.
+ */
+class BookManager {
+public:
+    // Value stored in BestBids()/BestAsks() while a side is empty
+    static constexpr Price kNoPrice = 0;
+
+    /**
+     * tracked_depth is the N used for the top-N quantity arrays; every
+     * book tracks it incrementally (see OrderBook::TrackDepth).
+     */
+    explicit BookManager(size_t tracked_depth = 10);
+
+    /**
+     * Intern a symbol (case-insensitive) and create its book.
+     * Returns the existing id if the symbol was already added.
+     */
+    SymbolId AddSymbol(std::string_view symbol,
+                       int price_decimals = 2,
+                       int quantity_decimals = 8,
+                       Price tick_size = 1,
+                       size_t ladder_ticks = OrderBook::kDefaultLadderTicks);
+
+    /**
+     * Subscribe-time lookup; not meant for the per-message path.
+     */
+    std::optional<SymbolId> FindSymbol(std::string_view symbol) const;
+
+    OrderBook& Book(SymbolId id) { return *books_[id]; }
+    const OrderBook& Book(SymbolId id) const { return *books_[id]; }
+    const std::string& Symbol(SymbolId id) const { return symbols_[id]; }
+    size_t SymbolCount() const { return books_.size(); }
+    size_t TrackedDepth() const { return tracked_depth_; }
+
+    // === Routed Updates ===
+
+    BatchResult ApplyBatch(SymbolId id,
+                           std::span<const LevelDelta> bids,
+                           std::span<const LevelDelta> asks);
+
+    // See OrderBook::ApplyTicker
+    bool ApplyTicker(SymbolId id, const TopOfBook& quote);
+
+    // See OrderBook::LoadSnapshot
+    void LoadSnapshot(SymbolId id,
+                      std::span<const LevelDelta> bids,
+                      std::span<const LevelDelta> asks,
+                      int64_t last_update_id);
+
+    void Update(SymbolId id, Side side, Price price, Quantity quantity);
+    void Clear(SymbolId id);
+
+    /**
+     * Re-read one symbol's top of book into the arrays below. Call after
+     * touching Book(id) directly.
+     */
+    void RefreshTop(SymbolId id);
+
+    // === Cross-Symbol Views (indexed by SymbolId) ===
+
+    std::span<const Price> BestBids() const { return best_bids_; }
+    std::span<const Price> BestAsks() const { return best_asks_; }
+    std::span<const Quantity> BidDepthQuantities() const { return bid_depth_qty_; }
+    std::span<const Quantity> AskDepthQuantities() const { return ask_depth_qty_; }
+
+private:
+    static std::string Normalize(std::string_view symbol);
+
+    size_t tracked_depth_;
+
+    std::vector<std::unique_ptr<OrderBook>> books_;
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, SymbolId> ids_;
+
+    // Structure of arrays, one entry per SymbolId
+    std::vector<Price> best_bids_;
+    std::vector<Price> best_asks_;
+    std::vector<Quantity> bid_depth_qty_;
+    std::vector<Quantity> ask_depth_qty_;
+};
+
+}  // namespace hft
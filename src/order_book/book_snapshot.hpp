@@ -0,0 +1,345 @@
+#pragma once
+
+#include "types.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace hft {
+
+/**
+ * 64 consecutive ticks of one side of the book. Immutable once published
+ * and shared between every snapshot in which it did not change.
+ */
+struct LevelPage {
+    static constexpr size_t kSlots = 64;
+
+    int64_t index = 0;      // Absolute tick / kSlots
+    uint64_t occupied = 0;  // Bit s set if quantities[s] != 0
+    std::array<Quantity, kSlots> quantities{};
+};
+
+using PagePtr = std::shared_ptr<const LevelPage>;
+
+/**
+ * 64 consecutive pages of one side; null where a page is empty. Immutable
+ * once published. A publish copies only the chunks with a dirty page, and
+ * a snapshot's page table is one pointer per chunk rather than per page.
+ */
+struct PageChunk {
+    static constexpr size_t kPages = 64;
+
+    int64_t index = 0;     // Page index / kPages
+    uint64_t present = 0;  // Bit p set if pages[p] is non-null
+    std::array<PagePtr, kPages> pages{};
+};
+
+using ChunkPtr = std::shared_ptr<const PageChunk>;
+
+/**
+ * Immutable image of both sides of a book. Chunks are sorted by ascending
+ * price; unchanged chunks are shared with the previous snapshot.
+ */
+struct BookSnapshot {
+    Price tick_size = 1;
+    uint64_t update_count = 0;
+    int64_t last_update_id = 0;
+    Timestamp timestamp = 0;
+
+    std::vector<ChunkPtr> bid_chunks;
+    std::vector<ChunkPtr> ask_chunks;
+
+    /**
+     * Visit up to n levels from the touch outward: fn(price, quantity).
+     */
+    template <typename Fn>
+    void ForEachLevel(Side side, size_t n, Fn&& fn) const {
+        size_t visited = 0;
+        if (side == Side::kBuy) {
+            for (auto chunk = bid_chunks.rbegin(); chunk != bid_chunks.rend(); ++chunk) {
+                for (uint64_t pages = (*chunk)->present; pages != 0;) {
+                    size_t p = 63 - static_cast<size_t>(std::countl_zero(pages));
+                    pages &= ~(uint64_t{1} << p);
+                    const LevelPage& page = *(*chunk)->pages[p];
+                    for (uint64_t bits = page.occupied; bits != 0 && visited < n; ++visited) {
+                        size_t slot = 63 - static_cast<size_t>(std::countl_zero(bits));
+                        bits &= ~(uint64_t{1} << slot);
+                        fn(PriceAt(page, slot), page.quantities[slot]);
+                    }
+                    if (visited == n) return;
+                }
+            }
+        } else {
+            for (const auto& chunk : ask_chunks) {
+                for (uint64_t pages = chunk->present; pages != 0; pages &= pages - 1) {
+                    const LevelPage& page = *chunk->pages[std::countr_zero(pages)];
+                    for (uint64_t bits = page.occupied; bits != 0 && visited < n; ++visited) {
+                        size_t slot = static_cast<size_t>(std::countr_zero(bits));
+                        bits &= bits - 1;
+                        fn(PriceAt(page, slot), page.quantities[slot]);
+                    }
+                    if (visited == n) return;
+                }
+            }
+        }
+    }
+
+    std::vector<PriceLevel> GetTopLevels(Side side, size_t n) const {
+        std::vector<PriceLevel> levels;
+        ForEachLevel(side, n, [&](Price price, Quantity quantity) {
+            levels.emplace_back(price, quantity);
+        });
+        return levels;
+    }
+
+    std::optional<Price> GetBestBid() const {
+        std::optional<Price> best;
+        ForEachLevel(Side::kBuy, 1, [&](Price price, Quantity) { best = price; });
+        return best;
+    }
+
+    std::optional<Price> GetBestAsk() const {
+        std::optional<Price> best;
+        ForEachLevel(Side::kSell, 1, [&](Price price, Quantity) { best = price; });
+        return best;
+    }
+
+    size_t GetLevelCount(Side side) const {
+        size_t count = 0;
+        for (const auto& chunk : side == Side::kBuy ? bid_chunks : ask_chunks) {
+            for (uint64_t pages = chunk->present; pages != 0; pages &= pages - 1) {
+                count += static_cast<size_t>(
+                    std::popcount(chunk->pages[std::countr_zero(pages)]->occupied));
+            }
+        }
+        return count;
+    }
+
+private:
+    Price PriceAt(const LevelPage& page, size_t slot) const {
+        return (page.index * static_cast<int64_t>(LevelPage::kSlots) +
+                static_cast<int64_t>(slot)) * tick_size;
+    }
+};
+
+/**
+ * How often the book publishes a snapshot on its own. Zero disables a
+ * trigger; with both zero only PublishSnapshot() publishes.
+ */
+struct SnapshotPolicy {
+    uint64_t every_updates = 0;
+    Timestamp every_nanos = 0;
+};
+
+/**
+ * Writer-side state for copy-on-write snapshots.
+ *
+ * The writer marks the page of every price it touches. Publishing
+ * rebuilds only those pages and the chunks holding them, reuses the rest
+ * from the previous snapshot and swaps the result into an atomic
+ * shared_ptr. Readers pin a snapshot by copying the shared_ptr; the last
+ * holder frees it, so the writer never waits for a reader to finish with
+ * a snapshot.
+ *
+ * The swap itself is not lock-free: std::atomic<shared_ptr> (libstdc++)
+ * guards the pointer with a spin bit held for a reference-count update,
+ * and without it (e.g. libc++) the atomic_* free functions take a mutex
+ * from a global pool. Either way the critical section is a few
+ * instructions, once per publish and once per Current().
+ */
+class SnapshotPublisher {
+public:
+    SnapshotPublisher(Price tick_size, SnapshotPolicy policy)
+        : tick_size_(tick_size), policy_(policy) {}
+
+    void MarkDirty(Side side, Price price) {
+        auto& state = SideState(side);
+        int64_t index = PageIndex(price);
+        int64_t chunk = index >> 6;  // Floor, also for negative indices
+        if (chunk < state.dirty_base ||
+            chunk - state.dirty_base >= static_cast<int64_t>(state.dirty.size())) {
+            GrowDirty(state, chunk);
+        }
+        uint64_t& word = state.dirty[static_cast<size_t>(chunk - state.dirty_base)];
+        if (word == 0) state.dirty_chunks.push_back(chunk);
+        word |= uint64_t{1} << (index & 63);
+        ++pending_updates_;
+    }
+
+    // Drop every page of a side; the next snapshot shows it empty
+    void ClearSide(Side side) {
+        auto& state = SideState(side);
+        state.chunks.clear();
+        ClearDirty(state);
+        ++pending_updates_;
+    }
+
+    /**
+     * True if the cadence asks for a snapshot now.
+     */
+    bool Due(Timestamp now) const {
+        if (pending_updates_ == 0) return false;
+        if (policy_.every_updates != 0 && pending_updates_ >= policy_.every_updates) return true;
+        return policy_.every_nanos != 0 && now - last_publish_ >= policy_.every_nanos;
+    }
+
+    bool TimeTriggered() const { return policy_.every_nanos != 0; }
+
+    /**
+     * Rebuild dirty pages with get(side, price) and publish.
+     */
+    template <typename GetFn>
+    void Publish(GetFn&& get, uint64_t update_count, int64_t last_update_id, Timestamp now) {
+        Rebuild(Side::kBuy, get);
+        Rebuild(Side::kSell, get);
+
+        auto snapshot = std::make_shared<BookSnapshot>();
+        snapshot->tick_size = tick_size_;
+        snapshot->update_count = update_count;
+        snapshot->last_update_id = last_update_id;
+        snapshot->timestamp = now;
+        snapshot->bid_chunks = bids_.chunks;
+        snapshot->ask_chunks = asks_.chunks;
+
+        std::shared_ptr<const BookSnapshot> published(std::move(snapshot));
+#if defined(__cpp_lib_atomic_shared_ptr)
+        current_.store(std::move(published), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&current_, std::move(published), std::memory_order_release);
+#endif
+        pending_updates_ = 0;
+        last_publish_ = now;
+    }
+
+    /**
+     * Latest snapshot, or null before the first publish. Any thread.
+     */
+    std::shared_ptr<const BookSnapshot> Current() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return current_.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+#endif
+    }
+
+private:
+    // 2 KiB per side covers 2^20 ticks around the first price marked, the
+    // whole of any realistic book, so the bitmap is allocated once
+    static constexpr size_t kDirtyWords = 256;
+
+    struct Chunks {
+        std::vector<ChunkPtr> chunks;  // Sorted by chunk index, none empty
+        // Bit per page touched since the last publish, so repeated updates
+        // to one page cost a single bit; word w covers chunk dirty_base + w
+        std::vector<uint64_t> dirty;
+        int64_t dirty_base = 0;
+        std::vector<int64_t> dirty_chunks;  // Chunks whose word is non-zero
+    };
+
+    Chunks& SideState(Side side) { return side == Side::kBuy ? bids_ : asks_; }
+
+    int64_t PageIndex(Price price) const {
+        int64_t tick = price / tick_size_;
+        int64_t slots = static_cast<int64_t>(LevelPage::kSlots);
+        return tick >= 0 ? tick / slots : (tick - slots + 1) / slots;
+    }
+
+    // First mark, or a price outside the bitmap: recentre with at least
+    // kDirtyWords of headroom on both sides
+    static void GrowDirty(Chunks& state, int64_t chunk) {
+        int64_t half = static_cast<int64_t>(kDirtyWords) / 2;
+        if (state.dirty.empty()) {
+            state.dirty.assign(kDirtyWords, 0);
+            state.dirty_base = chunk - half;
+            return;
+        }
+        int64_t low = std::min(state.dirty_base, chunk) - half;
+        int64_t high = std::max(state.dirty_base + static_cast<int64_t>(state.dirty.size()),
+                                chunk + 1) + half;
+        std::vector<uint64_t> grown(static_cast<size_t>(high - low), 0);
+        std::copy(state.dirty.begin(), state.dirty.end(),
+                  grown.begin() + (state.dirty_base - low));
+        state.dirty = std::move(grown);
+        state.dirty_base = low;
+    }
+
+    static void ClearDirty(Chunks& state) {
+        for (int64_t chunk : state.dirty_chunks) {
+            state.dirty[static_cast<size_t>(chunk - state.dirty_base)] = 0;
+        }
+        state.dirty_chunks.clear();  // Keeps capacity
+    }
+
+    template <typename GetFn>
+    void Rebuild(Side side, GetFn& get) {
+        auto& state = SideState(side);
+        for (int64_t chunk : state.dirty_chunks) {
+            RebuildChunk(side, state, chunk,
+                         state.dirty[static_cast<size_t>(chunk - state.dirty_base)], get);
+        }
+        ClearDirty(state);
+    }
+
+    template <typename GetFn>
+    void RebuildChunk(Side side, Chunks& state, int64_t index, uint64_t dirty, GetFn& get) {
+        auto it = std::lower_bound(state.chunks.begin(), state.chunks.end(), index,
+                                   [](const ChunkPtr& c, int64_t i) { return c->index < i; });
+        bool present = it != state.chunks.end() && (*it)->index == index;
+        auto chunk = present ? std::make_shared<PageChunk>(**it) : std::make_shared<PageChunk>();
+        chunk->index = index;
+        for (uint64_t bits = dirty; bits != 0; bits &= bits - 1) {
+            RebuildPage(side, *chunk, static_cast<size_t>(std::countr_zero(bits)), get);
+        }
+
+        if (chunk->present == 0) {
+            if (present) state.chunks.erase(it);
+        } else if (present) {
+            *it = std::move(chunk);
+        } else {
+            state.chunks.insert(it, std::move(chunk));
+        }
+    }
+
+    template <typename GetFn>
+    void RebuildPage(Side side, PageChunk& chunk, size_t p, GetFn& get) {
+        auto page = std::make_shared<LevelPage>();
+        page->index = chunk.index * static_cast<int64_t>(PageChunk::kPages) +
+                      static_cast<int64_t>(p);
+        Price base = page->index * static_cast<int64_t>(LevelPage::kSlots) * tick_size_;
+        for (size_t slot = 0; slot < LevelPage::kSlots; ++slot) {
+            Quantity quantity = get(side, base + static_cast<int64_t>(slot) * tick_size_);
+            page->quantities[slot] = quantity;
+            if (quantity != 0) page->occupied |= uint64_t{1} << slot;
+        }
+
+        if (page->occupied == 0) {
+            chunk.pages[p].reset();
+            chunk.present &= ~(uint64_t{1} << p);
+        } else {
+            chunk.pages[p] = std::move(page);
+            chunk.present |= uint64_t{1} << p;
+        }
+    }
+
+    Price tick_size_;
+    SnapshotPolicy policy_;
+    uint64_t pending_updates_ = 0;
+    Timestamp last_publish_ = 0;
+
+    Chunks bids_;
+    Chunks asks_;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const BookSnapshot>> current_;
+#else
+    std::shared_ptr<const BookSnapshot> current_;  // Via the atomic_* free functions
+#endif
+};
+
+}  // namespace hft
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Fenwick (binary indexed) tree over a fixed number of slots.
+ * Point update, prefix sum and prefix search are all O(log N).
+ * LowerBound() assumes every slot value is non-negative.
+ */
+template <typename T>
+class FenwickTree {
+public:
+    explicit FenwickTree(size_t size = 0)
+        : tree_(size + 1, T{})
+        , top_bit_(size > 0 ? std::bit_floor(size) : 0) {}
+
+    size_t Size() const { return tree_.size() - 1; }
+
+    void Add(size_t index, T delta) {
+        for (size_t i = index + 1; i < tree_.size(); i += i & (~i + 1)) {
+            tree_[i] += delta;
+        }
+    }
+
+    /**
+     * Sum of slots [0, count).
+     */
+    T PrefixSum(size_t count) const {
+        T sum{};
+        for (size_t i = std::min(count, Size()); i > 0; i &= i - 1) {
+            sum += tree_[i];
+        }
+        return sum;
+    }
+
+    /**
+     * Smallest index whose inclusive prefix sum reaches `target`,
+     * or Size() if the total is below it.
+     */
+    size_t LowerBound(T target) const {
+        size_t pos = 0;
+        for (size_t step = top_bit_; step > 0; step >>= 1) {
+            size_t next = pos + step;
+            if (next <= Size() && tree_[next] < target) {
+                pos = next;
+                target -= tree_[next];
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * Rebuild from value(i) for every slot in O(N).
+     */
+    template <typename ValueFn>
+    void Build(ValueFn&& value) {
+        for (size_t i = 1; i < tree_.size(); ++i) {
+            tree_[i] = value(i - 1);
+        }
+        for (size_t i = 1; i < tree_.size(); ++i) {
+            size_t parent = i + (i & (~i + 1));
+            if (parent < tree_.size()) tree_[parent] += tree_[i];
+        }
+    }
+
+    void Reset() { std::fill(tree_.begin(), tree_.end(), T{}); }
+
+private:
+    std::vector<T> tree_;  // 1-based
+    size_t top_bit_;
+};
+
+}  // namespace hft
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Hierarchical occupancy bitmap over slot indices.
+ *
+ * Level 0 has one bit per slot. Each higher level has one bit per word of
+ * the level below, set when that word is non-zero, until a level fits in
+ * a single word (3 levels cover 262144 slots). Finding the next occupied
+ * slot is a ctz per level on the way up and down, independent of how
+ * many empty slots lie in between.
+ */
+class OccupancyBitmap {
+public:
+    explicit OccupancyBitmap(size_t size) : size_(size) {
+        size_t bits = size;
+        do {
+            size_t words = (bits + 63) / 64;
+            levels_.emplace_back(words, 0);
+            bits = words;
+        } while (bits > 1);
+    }
+
+    void Set(size_t index) {
+        for (auto& level : levels_) {
+            uint64_t& word = level[index >> 6];
+            bool was_empty = (word == 0);
+            word |= Bit(index);
+            if (!was_empty) return;
+            index >>= 6;
+        }
+    }
+
+    void Clear(size_t index) {
+        for (auto& level : levels_) {
+            uint64_t& word = level[index >> 6];
+            word &= ~Bit(index);
+            if (word != 0) return;
+            index >>= 6;
+        }
+    }
+
+    bool Test(size_t index) const {
+        return (levels_[0][index >> 6] & Bit(index)) != 0;
+    }
+
+    /**
+     * First set index >= from, or Size() if there is none.
+     */
+    size_t FindNext(size_t from) const {
+        if (from >= size_) return size_;
+
+        size_t level = 0;
+        size_t pos = from;
+        for (;;) {
+            const auto& words = levels_[level];
+            size_t w = pos >> 6;
+            if (w >= words.size()) return size_;
+
+            uint64_t word = words[w] & (~uint64_t{0} << (pos & 63));
+            if (word != 0) {
+                pos = (w << 6) | static_cast<size_t>(std::countr_zero(word));
+                break;
+            }
+            if (++level == levels_.size()) return size_;
+            pos = w + 1;  // Next word below == next bit one level up
+        }
+
+        while (level > 0) {
+            --level;
+            pos = (pos << 6) | static_cast<size_t>(std::countr_zero(levels_[level][pos]));
+        }
+        return pos;
+    }
+
+    /**
+     * Last set index <= from, or Size() if there is none.
+     */
+    size_t FindPrev(size_t from) const {
+        if (from >= size_) from = size_ - 1;
+
+        size_t level = 0;
+        size_t pos = from;
+        for (;;) {
+            size_t w = pos >> 6;
+            uint64_t word = levels_[level][w] & (~uint64_t{0} >> (63 - (pos & 63)));
+            if (word != 0) {
+                pos = (w << 6) | static_cast<size_t>(63 - std::countl_zero(word));
+                break;
+            }
+            if (w == 0 || ++level == levels_.size()) return size_;
+            pos = w - 1;  // Previous word below == previous bit one level up
+        }
+
+        while (level > 0) {
+            --level;
+            pos = (pos << 6) | static_cast<size_t>(63 - std::countl_zero(levels_[level][pos]));
+        }
+        return pos;
+    }
+
+    /**
+     * Reset all bits. Only level-0 words flagged in the summary are touched.
+     */
+    void ClearAll() {
+        if (levels_.size() == 1) {
+            levels_[0][0] = 0;
+            return;
+        }
+        const auto& summary = levels_[1];
+        for (size_t w = 0; w < summary.size(); ++w) {
+            for (uint64_t bits = summary[w]; bits != 0; bits &= bits - 1) {
+                levels_[0][(w << 6) | static_cast<size_t>(std::countr_zero(bits))] = 0;
+            }
+        }
+        for (size_t l = 1; l < levels_.size(); ++l) {
+            std::fill(levels_[l].begin(), levels_[l].end(), 0);
+        }
+    }
+
+    /**
+     * Call fn(index) for every set bit, in ascending order.
+     */
+    template <typename Fn>
+    void ForEachSet(Fn&& fn) const {
+        for (size_t i = FindNext(0); i < size_; i = FindNext(i + 1)) {
+            fn(i);
+        }
+    }
+
+    // Raw level-0 word holding bits [64 * w, 64 * w + 63]
+    uint64_t Word(size_t w) const { return levels_[0][w]; }
+
+    bool Empty() const { return levels_.back()[0] == 0; }
+    size_t Size() const { return size_; }
+
+private:
+    static uint64_t Bit(size_t index) { return uint64_t{1} << (index & 63); }
+
+    size_t size_;
+    std::vector<std::vector<uint64_t>> levels_;  // levels_[0] = one bit per slot
+};
+
+}  // namespace hft
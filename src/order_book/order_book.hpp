@@ -1,37 +1,116 @@
 #pragma once
 
 #include "types.hpp"
-#include <unordered_map>
-#include <set>
+#include "book_snapshot.hpp"
+#include "fixed_point.hpp"
+#include "price_ladder.hpp"
+#include "top_of_book.hpp"
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include <optional>
-#include <functional>
+#include <span>
+#include <string_view>
+#include <utility>
 
 namespace hft {
 
+/**
+ * What a batch of level deltas changed, per side.
+ * Ranks count from 0 at the touch; every level shallower than the
+ * reported rank is unchanged by the batch.
+ */
+struct BatchResult {
+    static constexpr size_t kMaxRank = 64;  // Ranks at or beyond this are reported as kMaxRank
+
+    bool bids_changed = false;
+    bool asks_changed = false;
+    bool best_bid_changed = false;  // Best bid price or its quantity
+    bool best_ask_changed = false;
+    size_t first_bid_rank = kMaxRank;  // Shallowest changed bid rank
+    size_t first_ask_rank = kMaxRank;
+
+    /**
+     * True if any of the top n levels on a side may differ.
+     */
+    bool TopChanged(Side side, size_t n) const {
+        return (side == Side::kBuy ? first_bid_rank : first_ask_rank) < n;
+    }
+};
+
+// === Book Traits ===
+// A traits type provides `price_decimals`, `quantity_decimals`, a ladder
+// `Geometry` type with a `geometry` value, and ParsePrice/ParseQuantity.
+
+/**
+ * Precision and ladder geometry chosen at runtime (used by OrderBook).
+ */
+struct RuntimeBookTraits {
+    using Geometry = DynamicLadderGeometry;
+
+    int price_decimals = 2;
+    int quantity_decimals = 8;
+    Geometry geometry;
+
+    Price ParsePrice(std::string_view s) const {
+        return SymbolConfig::StringToFixed(s, price_decimals);
+    }
+    Quantity ParseQuantity(std::string_view s) const {
+        return SymbolConfig::StringToFixed(s, quantity_decimals);
+    }
+};
+
+/**
+ * Precision and ladder geometry fixed at compile time. Conversions use
+ * FixedPoint<> constants and the ladder index math divides by a constant.
+ * MaxDepth is the number of tick slots held per side in the flat ladder.
+ */
+template <int PriceDecimals, int QtyDecimals, size_t MaxDepth, Price TickSize = 1>
+struct StaticBookTraits {
+    using Geometry = StaticLadderGeometry<TickSize, MaxDepth>;
+
+    static constexpr int price_decimals = PriceDecimals;
+    static constexpr int quantity_decimals = QtyDecimals;
+    static constexpr Geometry geometry{};
+
+    static Price ParsePrice(std::string_view s) {
+        return FixedPoint<PriceDecimals>::Parse(s);
+    }
+    static Quantity ParseQuantity(std::string_view s) {
+        return FixedPoint<QtyDecimals>::Parse(s);
+    }
+};
+
 /**
  * High-performance order book for market data tracking.
- * 
+ *
  * Design goals:
- * - update(): O(log N) worst case
- * - getBestBid/Ask(): O(1) with caching
- * - getQuantityAt(): O(1) hash lookup
- * 
+ * - update(): O(1) indexed store for levels inside the ladder window
+ * - getBestBid/Ask(): O(1), best level tracked eagerly
+ * - getQuantityAt(): O(1) indexed load
+ *
  * This is a "market data" order book that tracks aggregate quantities
  * at each price level, as received from exchange feeds (e.g., Binance).
  * It does NOT perform order matching - that happens on the exchange.
- * 
- * Future optimizations:
- * - Memory pool to avoid dynamic allocation
- * - Cache-friendly data layout
- * - Lock-free updates for multi-threaded access
+ *
+ * Each side is a PriceLadder: a contiguous array indexed by tick distance
+ * from an anchor price, with an ordered overflow map for levels far from
+ * the touch. See price_ladder.hpp.
+ *
+ * Traits fix precision and ladder geometry either at runtime (OrderBook)
+ * or at compile time (StaticOrderBook).
+ *
+ * Threading: one writer thread owns the book. Other threads may only call
+ * GetTopOfBook(), which reads a seqlock-published copy of the touch, and
+ * GetSnapshot() for a full immutable image.
  */
-class OrderBook {
+template <typename Traits>
+class BasicOrderBook {
 public:
-    explicit OrderBook(const std::string& symbol, 
-                       int price_decimals = 2, 
-                       int quantity_decimals = 8);
-    
+    using Ladder = BasicPriceLadder<typename Traits::Geometry>;
+
+    explicit BasicOrderBook(const std::string& symbol, Traits traits = Traits());
+
     // === Core Operations ===
 
     /**
@@ -45,9 +124,40 @@ public:
      * Update from string format (for Binance API compatibility).
      * Converts strings to fixed-point integers internally.
      */
-    void UpdateFromStrings(Side side, 
-                           const std::string& price_str,
-                           const std::string& quantity_str);
+    void UpdateFromStrings(Side side,
+                           std::string_view price_str,
+                           std::string_view quantity_str);
+
+    /**
+     * Apply all level changes of one depth message as a single transaction.
+     * Target slots are prefetched up front and the best prices are
+     * compared once at the end. update_count_ grows by the number of
+     * deltas, as if each had gone through Update().
+     */
+    BatchResult ApplyBatch(std::span<const LevelDelta> bids,
+                           std::span<const LevelDelta> asks);
+
+    /**
+     * Merge a best bid/ask quote (e.g. Binance bookTicker) whose
+     * `sequence` is the exchange update id. Each quoted price becomes the
+     * best level of its side, dropping any levels in front of it; a side
+     * with price 0 is left alone. Returns false, changing nothing, if the
+     * book already reflects a later update id.
+     *
+     * Until a diff newer than the quote is applied, ApplyBatch() keeps the
+     * quote's touch: deltas at or through a quoted price are skipped for
+     * batches whose SetLastUpdateId() is older than the quote.
+     */
+    bool ApplyTicker(const TopOfBook& quote);
+
+    /**
+     * Replace both sides with a full depth snapshot taken at
+     * `last_update_id` (bulk load; see PriceLadder::Assign). Drops any
+     * merged ticker quote.
+     */
+    void LoadSnapshot(std::span<const LevelDelta> bids,
+                      std::span<const LevelDelta> asks,
+                      int64_t last_update_id);
 
     /**
      * Clear all price levels (e.g., when receiving a new snapshot).
@@ -88,42 +198,527 @@ public:
      */
     std::vector<PriceLevel> GetTopLevels(Side side, size_t n) const;
 
+    /**
+     * Non-allocating form: fill `out` with up to out.size() top levels.
+     * Returns the number of levels written.
+     */
+    size_t GetTopLevels(Side side, std::span<PriceLevel> out) const;
+
+    /**
+     * Visit up to n top levels in order: fn(price, quantity).
+     */
+    template <typename Fn>
+    void ForEachLevel(Side side, size_t n, Fn&& fn) const {
+        SideLadder(side).ForEach(n, std::forward<Fn>(fn));
+    }
+
+    /**
+     * Lightweight range over up to n top levels, yielding PriceLevel by
+     * value. Valid until the next update to the book.
+     *
+     *   for (const PriceLevel& level : book.TopLevels(Side::kBuy, 10)) ...
+     */
+    class LevelRange {
+    public:
+        LevelRange(const Ladder& ladder, size_t n) : ladder_(&ladder), n_(n) {}
+        typename Ladder::LevelIterator begin() const { return ladder_->Begin(n_); }
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        const Ladder* ladder_;
+        size_t n_;
+    };
+
+    LevelRange TopLevels(Side side, size_t n) const {
+        return LevelRange(SideLadder(side), n);
+    }
+
     /**
      * Get number of active price levels on one side.
      */
     size_t GetLevelCount(Side side) const;
 
+    // === Depth Aggregates ===
+
+    /**
+     * Maintain the cumulative quantity of the top `depth` levels on both
+     * sides incrementally inside Update(). Call once per depth at setup.
+     */
+    void TrackDepth(size_t depth);
+
+    /**
+     * Sum of quantity over the top `depth` levels.
+     * O(1) for tracked depths, otherwise walks the levels.
+     */
+    Quantity GetDepthQuantity(Side side, size_t depth) const;
+
+    // === Sweep Queries ===
+    // `side` is the side being consumed: Side::kSell prices a buy order
+    // against resting asks. Without EnableCumulativeIndex() these walk the
+    // levels; with it they are O(log N) for levels inside the ladder.
+
+    /**
+     * Maintain cumulative quantity and notional indexes inside Update().
+     */
+    void EnableCumulativeIndex();
+
+    /**
+     * Worst price reached when filling `quantity` against `side`.
+     * Returns nullopt if the side holds less than `quantity`.
+     */
+    std::optional<Price> PriceForQuantity(Side side, Quantity quantity) const;
+
+    /**
+     * Average fill price for `quantity` against `side`.
+     * Returns nullopt if the side holds less than `quantity`.
+     */
+    std::optional<Price> VwapForQuantity(Side side, Quantity quantity) const;
+
+    /**
+     * Quantity resting on `side` within `bps` basis points of mid.
+     * Returns 0 if either side is empty.
+     */
+    Quantity QuantityWithin(Side side, double bps) const;
+
+    // === Cross-Thread Top of Book ===
+
+    /**
+     * Exchange update id of the message being applied; stamped into the
+     * next published top of book. Writer thread only.
+     */
+    void SetLastUpdateId(int64_t update_id) { last_update_id_ = update_id; }
+    int64_t GetLastUpdateId() const { return last_update_id_; }
+
+    /**
+     * Consistent best bid/ask, safe to call from any thread. Republished
+     * by the writer only when a best price or its quantity changes, so
+     * `sequence` is the update id that last moved the touch.
+     */
+    TopOfBook GetTopOfBook() const { return top_.Read(); }
+
+    // === Snapshots ===
+
+    /**
+     * Start publishing copy-on-write snapshots at the given cadence and
+     * publish one immediately. Call before handing the book to readers.
+     */
+    void EnableSnapshots(SnapshotPolicy policy = SnapshotPolicy());
+
+    /**
+     * Publish a snapshot now, rebuilding only pages touched since the
+     * last one. No-op unless snapshots are enabled. Writer thread only.
+     */
+    void PublishSnapshot();
+
+    /**
+     * Latest published snapshot, or null. Safe from any thread; the
+     * snapshot stays valid for as long as the caller holds it.
+     */
+    std::shared_ptr<const BookSnapshot> GetSnapshot() const {
+        return snapshots_ ? snapshots_->Current() : nullptr;
+    }
+
     // === Statistics ===
 
     uint64_t GetUpdateCount() const { return update_count_; }
     const std::string& GetSymbol() const { return symbol_; }
-    int GetPriceDecimals() const { return price_decimals_; }
-    int GetQuantityDecimals() const { return quantity_decimals_; }
+    int GetPriceDecimals() const { return traits_.price_decimals; }
+    int GetQuantityDecimals() const { return traits_.quantity_decimals; }
+    Price GetTickSize() const { return bids_.GetTickSize(); }
 
 private:
-    void UpdateBid(Price price, Quantity quantity);
-    void UpdateAsk(Price price, Quantity quantity);
-    void InvalidateCache();
-    void RefreshCache() const;
+    Ladder& SideLadder(Side side) {
+        return side == Side::kBuy ? bids_ : asks_;
+    }
+    const Ladder& SideLadder(Side side) const {
+        return side == Side::kBuy ? bids_ : asks_;
+    }
 
-    std::string symbol_;
-    int price_decimals_;
-    int quantity_decimals_;
+    static void ApplySide(Ladder& ladder,
+                          std::span<const LevelDelta> deltas,
+                          std::optional<Price> guard,
+                          bool& changed,
+                          bool& best_changed,
+                          size_t& first_rank);
+
+    static bool IsBetter(Side side, Price a, Price b) {
+        return side == Side::kBuy ? a > b : a < b;
+    }
 
-    // Bid side: price -> quantity, with sorted price set (descending)
-    std::unordered_map<Price, Quantity> bids_;
-    std::set<Price, std::greater<Price>> bid_prices_;
+    size_t SetTouch(Side side, Price price, Quantity quantity);
 
-    // Ask side: price -> quantity, with sorted price set (ascending)
-    std::unordered_map<Price, Quantity> asks_;
-    std::set<Price> ask_prices_;
+    void PublishTop();
+    void MaybePublishSnapshot();
+
+    std::string symbol_;
+    [[no_unique_address]] Traits traits_;
 
-    // Cached best prices for O(1) access
-    mutable std::optional<Price> cached_best_bid_;
-    mutable std::optional<Price> cached_best_ask_;
-    mutable bool cache_valid_ = false;
+    Ladder bids_;
+    Ladder asks_;
 
     uint64_t update_count_ = 0;
+    int64_t last_update_id_ = 0;
+    TopOfBook ticker_;  // Last merged quote; sequence 0 if none
+
+    TopOfBook published_;  // Writer-side copy of the last publish
+    SeqlockTopOfBook top_;
+
+    std::unique_ptr<SnapshotPublisher> snapshots_;  // Null until EnableSnapshots()
 };
 
-}  // namespace hft
\ No newline at end of file
+/**
+ * Order book with precision and ladder geometry chosen at runtime.
+ * Thin adapter over BasicOrderBook<RuntimeBookTraits>.
+ */
+class OrderBook : public BasicOrderBook<RuntimeBookTraits> {
+public:
+    static constexpr size_t kDefaultLadderTicks = DynamicLadderGeometry::kDefaultWindow;
+
+    /**
+     * tick_size is in fixed-point price units (1 = any price accepted).
+     * ladder_ticks is the number of tick slots held per side in the flat
+     * array; levels further from the touch fall back to the overflow map.
+     */
+    explicit OrderBook(const std::string& symbol,
+                       int price_decimals = 2,
+                       int quantity_decimals = 8,
+                       Price tick_size = 1,
+                       size_t ladder_ticks = kDefaultLadderTicks);
+};
+
+/**
+ * Order book for a symbol whose precision is known at build time, e.g.
+ * StaticOrderBook<2, 8, 16384> for BTCUSDT.
+ */
+template <int PriceDecimals, int QtyDecimals, size_t MaxDepth, Price TickSize = 1>
+using StaticOrderBook =
+    BasicOrderBook<StaticBookTraits<PriceDecimals, QtyDecimals, MaxDepth, TickSize>>;
+
+// === BasicOrderBook implementation ===
+
+template <typename Traits>
+BasicOrderBook<Traits>::BasicOrderBook(const std::string& symbol, Traits traits)
+    : symbol_(symbol)
+    , traits_(traits)
+    , bids_(Side::kBuy, traits.geometry)
+    , asks_(Side::kSell, traits.geometry) {}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::Update(Side side, Price price, Quantity quantity) {
+    ++update_count_;
+    SideLadder(side).Set(price, quantity);
+    PublishTop();
+
+    if (snapshots_) {
+        snapshots_->MarkDirty(side, price);
+        MaybePublishSnapshot();
+    }
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::UpdateFromStrings(Side side,
+                                               std::string_view price_str,
+                                               std::string_view quantity_str) {
+    Price price = traits_.ParsePrice(price_str);
+    Quantity qty = traits_.ParseQuantity(quantity_str);
+    Update(side, price, qty);
+}
+
+// Applies one side of a batch and fills in the change summary for it.
+// Deltas at or better than `guard` are skipped.
+template <typename Traits>
+void BasicOrderBook<Traits>::ApplySide(Ladder& ladder,
+                                       std::span<const LevelDelta> deltas,
+                                       std::optional<Price> guard,
+                                       bool& changed,
+                                       bool& best_changed,
+                                       size_t& first_rank) {
+    for (const auto& delta : deltas) {
+        ladder.Prefetch(delta.price);
+    }
+
+    auto best_before = ladder.BestPrice();
+    Quantity best_qty_before = best_before ? ladder.Get(*best_before) : 0;
+
+    // Shallowest changed price, compared by distance from the touch
+    std::optional<Price> shallowest;
+    for (const auto& delta : deltas) {
+        if (guard && !IsBetter(ladder.GetSide(), *guard, delta.price)) continue;
+        if (ladder.Set(delta.price, delta.quantity) == delta.quantity) continue;
+
+        changed = true;
+        if (!shallowest || (ladder.GetSide() == Side::kBuy
+                                ? delta.price > *shallowest
+                                : delta.price < *shallowest)) {
+            shallowest = delta.price;
+        }
+    }
+
+    if (!changed) return;
+
+    auto best_after = ladder.BestPrice();
+    Quantity best_qty_after = best_after ? ladder.Get(*best_after) : 0;
+    best_changed = best_before != best_after || best_qty_before != best_qty_after;
+
+    // Levels better than every touched price were left alone, so their
+    // count is the same before and after the batch.
+    first_rank = ladder.RankOf(*shallowest, BatchResult::kMaxRank);
+}
+
+template <typename Traits>
+BatchResult BasicOrderBook<Traits>::ApplyBatch(std::span<const LevelDelta> bids,
+                                               std::span<const LevelDelta> asks) {
+    update_count_ += bids.size() + asks.size();
+
+    // A batch older than the merged quote must not overwrite its touch
+    std::optional<Price> bid_guard;
+    std::optional<Price> ask_guard;
+    if (ticker_.sequence > last_update_id_) {
+        if (ticker_.bid_price != 0) bid_guard = ticker_.bid_price;
+        if (ticker_.ask_price != 0) ask_guard = ticker_.ask_price;
+    }
+
+    BatchResult result;
+    ApplySide(bids_, bids, bid_guard, result.bids_changed,
+              result.best_bid_changed, result.first_bid_rank);
+    ApplySide(asks_, asks, ask_guard, result.asks_changed,
+              result.best_ask_changed, result.first_ask_rank);
+    if (result.best_bid_changed || result.best_ask_changed) {
+        PublishTop();
+    }
+
+    if (snapshots_) {
+        for (const auto& delta : bids) snapshots_->MarkDirty(Side::kBuy, delta.price);
+        for (const auto& delta : asks) snapshots_->MarkDirty(Side::kSell, delta.price);
+        MaybePublishSnapshot();
+    }
+    return result;
+}
+
+template <typename Traits>
+bool BasicOrderBook<Traits>::ApplyTicker(const TopOfBook& quote) {
+    if (quote.sequence <= std::max(last_update_id_, ticker_.sequence)) return false;
+    ticker_ = quote;
+
+    if (quote.bid_price != 0) {
+        update_count_ += SetTouch(Side::kBuy, quote.bid_price, quote.bid_quantity);
+    }
+    if (quote.ask_price != 0) {
+        update_count_ += SetTouch(Side::kSell, quote.ask_price, quote.ask_quantity);
+    }
+    PublishTop();
+
+    if (snapshots_) MaybePublishSnapshot();
+    return true;
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::LoadSnapshot(std::span<const LevelDelta> bids,
+                                          std::span<const LevelDelta> asks,
+                                          int64_t last_update_id) {
+    update_count_ += bids.size() + asks.size();
+    bids_.Assign(bids);
+    asks_.Assign(asks);
+    ticker_ = TopOfBook();
+    last_update_id_ = last_update_id;
+    PublishTop();
+
+    if (snapshots_) {
+        snapshots_->ClearSide(Side::kBuy);
+        snapshots_->ClearSide(Side::kSell);
+        for (const auto& level : bids) snapshots_->MarkDirty(Side::kBuy, level.price);
+        for (const auto& level : asks) snapshots_->MarkDirty(Side::kSell, level.price);
+        MaybePublishSnapshot();
+    }
+}
+
+// Makes (price, quantity) the best level of `side`, removing levels in
+// front of it. Returns the number of levels written.
+template <typename Traits>
+size_t BasicOrderBook<Traits>::SetTouch(Side side, Price price, Quantity quantity) {
+    Ladder& ladder = SideLadder(side);
+    size_t writes = 1;
+    for (auto best = ladder.BestPrice(); best && IsBetter(side, *best, price);
+         best = ladder.BestPrice()) {
+        ladder.Set(*best, 0);
+        if (snapshots_) snapshots_->MarkDirty(side, *best);
+        ++writes;
+    }
+    ladder.Set(price, quantity);
+    if (snapshots_) snapshots_->MarkDirty(side, price);
+    return writes;
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::Clear() {
+    bids_.Clear();
+    asks_.Clear();
+    ticker_ = TopOfBook();
+    PublishTop();
+
+    if (snapshots_) {
+        snapshots_->ClearSide(Side::kBuy);
+        snapshots_->ClearSide(Side::kSell);
+        MaybePublishSnapshot();
+    }
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::Clear(Side side) {
+    SideLadder(side).Clear();
+    PublishTop();
+
+    if (snapshots_) {
+        snapshots_->ClearSide(side);
+        MaybePublishSnapshot();
+    }
+}
+
+// Publishes only if the touch differs from what readers last saw.
+template <typename Traits>
+void BasicOrderBook<Traits>::PublishTop() {
+    auto bid = bids_.BestPrice();
+    auto ask = asks_.BestPrice();
+    Price bid_price = bid.value_or(0);
+    Price ask_price = ask.value_or(0);
+    Quantity bid_qty = bid ? bids_.Get(*bid) : 0;
+    Quantity ask_qty = ask ? asks_.Get(*ask) : 0;
+
+    if (bid_price == published_.bid_price && bid_qty == published_.bid_quantity &&
+        ask_price == published_.ask_price && ask_qty == published_.ask_quantity) {
+        return;
+    }
+
+    published_ = TopOfBook{bid_price, bid_qty, ask_price, ask_qty,
+                           std::max(last_update_id_, ticker_.sequence), NowNanos()};
+    top_.Publish(published_);
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::EnableSnapshots(SnapshotPolicy policy) {
+    snapshots_ = std::make_unique<SnapshotPublisher>(GetTickSize(), policy);
+    for (Side side : {Side::kBuy, Side::kSell}) {
+        const Ladder& ladder = SideLadder(side);
+        ladder.ForEach(ladder.LevelCount(), [&](Price price, Quantity) {
+            snapshots_->MarkDirty(side, price);
+        });
+    }
+    PublishSnapshot();
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::PublishSnapshot() {
+    if (!snapshots_) return;
+    snapshots_->Publish([this](Side side, Price price) { return SideLadder(side).Get(price); },
+                        update_count_, last_update_id_, NowNanos());
+}
+
+// The clock is only read when the cadence is time based.
+template <typename Traits>
+void BasicOrderBook<Traits>::MaybePublishSnapshot() {
+    Timestamp now = snapshots_->TimeTriggered() ? NowNanos() : 0;
+    if (snapshots_->Due(now)) PublishSnapshot();
+}
+
+template <typename Traits>
+std::optional<Price> BasicOrderBook<Traits>::GetBestBid() const {
+    return bids_.BestPrice();
+}
+
+template <typename Traits>
+std::optional<Price> BasicOrderBook<Traits>::GetBestAsk() const {
+    return asks_.BestPrice();
+}
+
+template <typename Traits>
+std::optional<Price> BasicOrderBook<Traits>::GetSpread() const {
+    auto bid = GetBestBid();
+    auto ask = GetBestAsk();
+    if (bid && ask) {
+        return *ask - *bid;
+    }
+    return std::nullopt;
+}
+
+template <typename Traits>
+std::optional<Price> BasicOrderBook<Traits>::GetMidPrice() const {
+    auto bid = GetBestBid();
+    auto ask = GetBestAsk();
+    if (bid && ask) {
+        return (*bid + *ask) / 2;
+    }
+    return std::nullopt;
+}
+
+template <typename Traits>
+Quantity BasicOrderBook<Traits>::GetQuantityAt(Side side, Price price) const {
+    return SideLadder(side).Get(price);
+}
+
+template <typename Traits>
+std::vector<PriceLevel> BasicOrderBook<Traits>::GetTopLevels(Side side, size_t n) const {
+    std::vector<PriceLevel> result;
+    result.reserve(n);
+
+    SideLadder(side).ForEach(n, [&](Price price, Quantity quantity) {
+        result.emplace_back(price, quantity);
+    });
+
+    return result;
+}
+
+template <typename Traits>
+size_t BasicOrderBook<Traits>::GetTopLevels(Side side, std::span<PriceLevel> out) const {
+    size_t count = 0;
+    SideLadder(side).ForEach(out.size(), [&](Price price, Quantity quantity) {
+        out[count++] = PriceLevel(price, quantity);
+    });
+    return count;
+}
+
+template <typename Traits>
+size_t BasicOrderBook<Traits>::GetLevelCount(Side side) const {
+    return SideLadder(side).LevelCount();
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::TrackDepth(size_t depth) {
+    bids_.TrackDepth(depth);
+    asks_.TrackDepth(depth);
+}
+
+template <typename Traits>
+Quantity BasicOrderBook<Traits>::GetDepthQuantity(Side side, size_t depth) const {
+    return SideLadder(side).DepthQuantity(depth);
+}
+
+template <typename Traits>
+void BasicOrderBook<Traits>::EnableCumulativeIndex() {
+    bids_.EnableCumulativeIndex();
+    asks_.EnableCumulativeIndex();
+}
+
+template <typename Traits>
+std::optional<Price> BasicOrderBook<Traits>::PriceForQuantity(Side side, Quantity quantity) const {
+    return SideLadder(side).PriceForQuantity(quantity);
+}
+
+template <typename Traits>
+std::optional<Price> BasicOrderBook<Traits>::VwapForQuantity(Side side, Quantity quantity) const {
+    return SideLadder(side).VwapForQuantity(quantity);
+}
+
+template <typename Traits>
+Quantity BasicOrderBook<Traits>::QuantityWithin(Side side, double bps) const {
+    auto mid = GetMidPrice();
+    if (!mid) return 0;
+
+    Price band = static_cast<Price>(static_cast<double>(*mid) * bps / 10000.0);
+    Price limit = (side == Side::kBuy) ? *mid - band : *mid + band;
+    return SideLadder(side).QuantityThrough(limit);
+}
+
+// Compiled once in order_book.cpp
+extern template class BasicOrderBook<RuntimeBookTraits>;
+
+}  // namespace hft
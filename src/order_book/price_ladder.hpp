@@ -0,0 +1,669 @@
+#pragma once
+
+#include "types.hpp"
+#include "occupancy_bitmap.hpp"
+#include "fenwick_tree.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace hft {
+
+/**
+ * Ladder geometry chosen at runtime (tick size and window width).
+ */
+class DynamicLadderGeometry {
+public:
+    static constexpr size_t kDefaultWindow = 16384;
+
+    DynamicLadderGeometry(Price tick_size = 1, size_t window_ticks = kDefaultWindow)
+        : tick_(tick_size > 0 ? tick_size : 1)
+        , window_(window_ticks > 0 ? window_ticks : 1) {}
+
+    Price Tick() const { return tick_; }
+    size_t Window() const { return window_; }
+
+private:
+    Price tick_;
+    size_t window_;
+};
+
+/**
+ * Ladder geometry fixed at compile time: index math divides by a
+ * constant and bounds checks compare against an immediate.
+ */
+template <Price TickSize, size_t WindowTicks>
+struct StaticLadderGeometry {
+    static_assert(TickSize > 0 && WindowTicks > 0, "Empty ladder geometry");
+
+    static constexpr Price Tick() { return TickSize; }
+    static constexpr size_t Window() { return WindowTicks; }
+};
+
+/**
+ * One side of the order book stored as a flat, tick-indexed array.
+ *
+ * Slot i holds the quantity at `anchor - i * tick` for bids and
+ * `anchor + i * tick` for asks, so on both sides slot 0 is the most
+ * aggressive price in the window and a lower index is a better price.
+ * An update near the touch is a single indexed store.
+ *
+ * An OccupancyBitmap over the slots finds the next level after the touch
+ * is pulled, and drives iteration, with a few ctz instructions.
+ *
+ * Cumulative quantity over the top N levels can be tracked for a few
+ * depths; it is maintained incrementally on every Set().
+ *
+ * An optional Fenwick index over the slots keeps cumulative quantity and
+ * notional from slot 0, for O(log N) sweep-cost and VWAP queries.
+ *
+ * Levels beyond the end of the window are kept in an ordered overflow
+ * map whose nodes come from a per-ladder pool, so once warm, inserts
+ * recycle freed nodes instead of hitting the heap. The best level always
+ * lives inside the window: the anchor is re-centred when a better price
+ * arrives or the touch drifts too deep.
+ *
+ * Prices must be multiples of the tick size (tick = 1 accepts any
+ * fixed-point price). Geometry supplies Tick() and Window(), either at
+ * runtime (DynamicLadderGeometry) or as constants (StaticLadderGeometry).
+ */
+template <typename Geometry>
+class BasicPriceLadder {
+    // Overflow levels by Key(price), nodes drawn from overflow_pool_
+    using OverflowMap = std::pmr::map<Price, Quantity>;
+
+public:
+    explicit BasicPriceLadder(Side side, Geometry geometry = Geometry())
+        : side_(side)
+        , geometry_(geometry)
+        , slots_(Window(), 0)
+        , occupied_(Window())
+        , best_(Window())
+        , overflow_pool_(std::make_unique<std::pmr::unsynchronized_pool_resource>())
+        , overflow_(overflow_pool_.get()) {
+        recenter_scratch_.reserve(Window());
+    }
+
+    /**
+     * Set quantity at a price level; 0 removes the level.
+     * Returns the previous quantity at that price.
+     */
+    Quantity Set(Price price, Quantity quantity) {
+        int64_t offset = Key(price) - Key(anchor_);
+
+        if (offset < 0 || Empty()) {
+            if (quantity == 0) return 0;  // Nothing can rest there
+            Recenter(price);
+            offset = Key(price) - Key(anchor_);
+        }
+
+        size_t index = static_cast<size_t>(offset / Tick());
+        if (index >= Window()) {
+            Quantity old = SetOverflow(price, quantity);
+            if (old != quantity) OnOverflowChanged();
+            return old;
+        }
+
+        Quantity old = slots_[index];
+        slots_[index] = quantity;
+
+        if (old == 0 && quantity != 0) {
+            ++window_levels_;
+            occupied_.Set(index);
+            if (index < best_) best_ = index;
+        } else if (old != 0 && quantity == 0) {
+            --window_levels_;
+            occupied_.Clear(index);
+        }
+
+        if (old != quantity) {
+            if (indexed_) {
+                cum_qty_.Add(index, quantity - old);
+                cum_notional_.Add(index, static_cast<Notional>(quantity - old) * price);
+            }
+            if (!depths_.empty()) OnSlotChanged(index, old, quantity);
+        }
+        // Last, since pulling the touch may re-centre the window
+        if (quantity == 0 && index == best_) AdvanceBest();
+        return old;
+    }
+
+    /**
+     * Start maintaining the total quantity of the best `depth` levels.
+     */
+    void TrackDepth(size_t depth) {
+        if (depth == 0 || FindDepth(depth) != nullptr) return;
+        depths_.push_back(DepthSum{depth, 0, 0, 0, false});
+        Recompute(depths_.back());
+    }
+
+    /**
+     * Total quantity of the best `depth` levels.
+     * O(1) for tracked depths, otherwise walks the levels.
+     */
+    Quantity DepthQuantity(size_t depth) const {
+        if (const DepthSum* tracked = FindDepth(depth)) return tracked->sum;
+
+        Quantity total = 0;
+        ForEach(depth, [&](Price, Quantity q) { total += q; });
+        return total;
+    }
+
+    /**
+     * Replace the whole side with `levels` (zero quantities skipped, the
+     * last entry wins for a repeated price). The window is anchored once
+     * on the best price, levels are written straight into their slots,
+     * and depth sums and indexes are rebuilt once at the end. Overflow
+     * inserts are O(1) when levels come best-first, as in a REST snapshot.
+     */
+    void Assign(std::span<const LevelDelta> levels) {
+        Clear();
+
+        std::optional<Price> best;
+        for (const auto& level : levels) {
+            if (level.quantity != 0 && (!best || Key(level.price) < Key(*best))) {
+                best = level.price;
+            }
+        }
+        if (!best) return;
+
+        PlaceAnchor(*best);
+        for (const auto& level : levels) {
+            if (level.quantity != 0) Place(level.price, level.quantity);
+        }
+
+        for (auto& tracked : depths_) Recompute(tracked);
+        if (indexed_) RebuildIndex();
+    }
+
+    Quantity Get(Price price) const {
+        int64_t offset = Key(price) - Key(anchor_);
+        if (offset < 0) return 0;
+
+        size_t index = static_cast<size_t>(offset / Tick());
+        if (index >= Window()) {
+            auto it = overflow_.find(Key(price));
+            return (it != overflow_.end()) ? it->second : 0;
+        }
+        return slots_[index];
+    }
+
+    /**
+     * Keep cumulative quantity/notional indexes over the window so the
+     * sweep queries below run in O(log N) instead of walking levels.
+     */
+    void EnableCumulativeIndex() {
+        if (indexed_) return;
+        indexed_ = true;
+        cum_qty_ = FenwickTree<Quantity>(Window());
+        cum_notional_ = FenwickTree<Notional>(Window());
+        RebuildIndex();
+    }
+
+    /**
+     * Worst price reached when taking `quantity` best-first, or nullopt if
+     * the side holds less than that.
+     */
+    std::optional<Price> PriceForQuantity(Quantity quantity) const {
+        auto fill = SweepTo(quantity);
+        if (!fill) return std::nullopt;
+        return fill->worst_price;
+    }
+
+    /**
+     * Average price paid when taking `quantity` best-first, rounded to the
+     * nearest fixed-point unit.
+     */
+    std::optional<Price> VwapForQuantity(Quantity quantity) const {
+        auto fill = SweepTo(quantity);
+        if (!fill) return std::nullopt;
+        return static_cast<Price>((fill->notional + quantity / 2) / quantity);
+    }
+
+    /**
+     * Total quantity resting at `limit` or better.
+     */
+    Quantity QuantityThrough(Price limit) const {
+        int64_t offset = Key(limit) - Key(anchor_);
+        if (offset < 0 || Empty()) return 0;
+
+        size_t last = static_cast<size_t>(offset / Tick());
+        Quantity total = 0;
+        if (indexed_) {
+            total = cum_qty_.PrefixSum(std::min(last + 1, Window()));
+        } else {
+            for (size_t i = best_; i < Window() && i <= last; i = occupied_.FindNext(i + 1)) {
+                total += slots_[i];
+            }
+        }
+        if (last < Window()) return total;
+
+        for (auto it = overflow_.begin(); it != overflow_.end() && it->first <= Key(limit); ++it) {
+            total += it->second;
+        }
+        return total;
+    }
+
+    /**
+     * Hint the cache that the slot for `price` is about to be written.
+     */
+    void Prefetch(Price price) const {
+        uint64_t index = static_cast<uint64_t>(Key(price) - Key(anchor_)) / static_cast<uint64_t>(Tick());
+        if (index < Window()) {
+            __builtin_prefetch(&slots_[index], 1);
+        }
+    }
+
+    /**
+     * Number of levels strictly better than `price`, capped at `limit`.
+     */
+    size_t RankOf(Price price, size_t limit) const {
+        if (best_ >= Window() || Key(price) <= Key(PriceAt(best_))) return 0;
+
+        size_t index = static_cast<size_t>((Key(price) - Key(anchor_)) / Tick());
+        if (index >= Window()) {
+            size_t rank = window_levels_;
+            for (auto it = overflow_.begin();
+                 it != overflow_.end() && it->first < Key(price) && rank < limit; ++it) {
+                ++rank;
+            }
+            return std::min(rank, limit);
+        }
+
+        // Popcount the occupied bits in [best_, index)
+        size_t rank = 0;
+        size_t w = best_ >> 6;
+        uint64_t word = occupied_.Word(w) & (~uint64_t{0} << (best_ & 63));
+        for (; w < (index >> 6) && rank < limit; word = occupied_.Word(++w)) {
+            rank += static_cast<size_t>(std::popcount(word));
+        }
+        if (w == (index >> 6)) {
+            word &= (uint64_t{1} << (index & 63)) - 1;
+            rank += static_cast<size_t>(std::popcount(word));
+        }
+        return std::min(rank, limit);
+    }
+
+    std::optional<Price> BestPrice() const {
+        if (best_ >= Window()) return std::nullopt;
+        return PriceAt(best_);
+    }
+
+    bool Empty() const { return window_levels_ == 0 && overflow_.empty(); }
+    size_t LevelCount() const { return window_levels_ + overflow_.size(); }
+
+    void Clear() {
+        occupied_.ForEachSet([&](size_t i) { slots_[i] = 0; });
+        occupied_.ClearAll();
+        overflow_.clear();
+        window_levels_ = 0;
+        best_ = Window();
+        for (auto& tracked : depths_) {
+            tracked = DepthSum{tracked.depth, 0, 0, 0, false};
+        }
+        if (indexed_) {
+            cum_qty_.Reset();
+            cum_notional_.Reset();
+        }
+    }
+
+    /**
+     * Visit up to n levels best-first: fn(price, quantity).
+     */
+    template <typename Fn>
+    void ForEach(size_t n, Fn&& fn) const {
+        size_t visited = 0;
+        for (size_t i = best_; i < Window() && visited < n; i = occupied_.FindNext(i + 1)) {
+            fn(PriceAt(i), slots_[i]);
+            ++visited;
+        }
+        for (auto it = overflow_.begin(); it != overflow_.end() && visited < n; ++it) {
+            fn(Key(it->first), it->second);
+            ++visited;
+        }
+    }
+
+    /**
+     * Forward iterator over up to n levels, best-first. Compares equal to
+     * std::default_sentinel once n levels were produced or the side ran out.
+     */
+    class LevelIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PriceLevel;
+        using difference_type = std::ptrdiff_t;
+
+        LevelIterator() = default;
+        LevelIterator(const BasicPriceLadder* ladder, size_t n)
+            : ladder_(ladder)
+            , remaining_(n)
+            , slot_(ladder->best_)
+            , overflow_(ladder->overflow_.begin()) {
+            if (slot_ >= ladder_->Window() && overflow_ == ladder_->overflow_.end()) {
+                remaining_ = 0;
+            }
+        }
+
+        PriceLevel operator*() const {
+            if (slot_ < ladder_->Window()) {
+                return PriceLevel(ladder_->PriceAt(slot_), ladder_->slots_[slot_]);
+            }
+            return PriceLevel(ladder_->Key(overflow_->first), overflow_->second);
+        }
+
+        LevelIterator& operator++() {
+            if (slot_ < ladder_->Window()) {
+                slot_ = ladder_->occupied_.FindNext(slot_ + 1);
+            } else {
+                ++overflow_;
+            }
+            if (--remaining_ > 0 && slot_ >= ladder_->Window() &&
+                overflow_ == ladder_->overflow_.end()) {
+                remaining_ = 0;
+            }
+            return *this;
+        }
+
+        LevelIterator operator++(int) {
+            LevelIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const LevelIterator& other) const {
+            return remaining_ == other.remaining_ && slot_ == other.slot_ &&
+                   (remaining_ == 0 || overflow_ == other.overflow_);
+        }
+        bool operator==(std::default_sentinel_t) const { return remaining_ == 0; }
+
+    private:
+        const BasicPriceLadder* ladder_ = nullptr;
+        size_t remaining_ = 0;
+        size_t slot_ = 0;
+        OverflowMap::const_iterator overflow_;
+    };
+
+    LevelIterator Begin(size_t n) const { return LevelIterator(this, n); }
+
+    Side GetSide() const { return side_; }
+    Price GetTickSize() const { return Tick(); }
+    size_t GetWindowTicks() const { return Window(); }
+
+private:
+    Price Tick() const { return geometry_.Tick(); }
+    size_t Window() const { return geometry_.Window(); }
+
+    // Signed distance key: ascending key = better price on both sides.
+    // The mapping is its own inverse, so Key(Key(p)) == p.
+    Price Key(Price price) const {
+        return side_ == Side::kBuy ? -price : price;
+    }
+
+    Price PriceAt(size_t index) const {
+        return Key(Key(anchor_) + static_cast<Price>(index) * Tick());
+    }
+
+    Quantity SetOverflow(Price price, Quantity quantity) {
+        auto it = overflow_.find(Key(price));
+        if (it == overflow_.end()) {
+            if (quantity != 0) overflow_.emplace(Key(price), quantity);
+            return 0;
+        }
+        Quantity old = it->second;
+        if (quantity == 0) {
+            overflow_.erase(it);
+        } else {
+            it->second = quantity;
+        }
+        return old;
+    }
+
+    void AdvanceBest() {
+        if (window_levels_ == 0) {
+            best_ = Window();
+            if (!overflow_.empty()) Recenter(Key(overflow_.begin()->first));
+            return;
+        }
+
+        best_ = occupied_.FindNext(best_ + 1);  // window_levels_ > 0 guarantees a hit
+
+        // Touch drifted deep into the window: re-centre so depth stays flat
+        if (best_ >= Window() - Window() / 4 && !overflow_.empty()) {
+            Recenter(PriceAt(best_));
+        }
+    }
+
+    /**
+     * Move the window so that `best_price` sits a quarter of the window
+     * from slot 0, leaving headroom for the touch to improve.
+     * O(window + moved levels); only runs when the market drifts.
+     *
+     * Window levels are stashed in a scratch buffer reserved up front and
+     * re-placed; overflow levels stay put unless the window now covers
+     * them. Nothing allocates once the overflow pool is warm.
+     */
+    void Recenter(Price best_price) {
+        recenter_scratch_.clear();
+        occupied_.ForEachSet([&](size_t i) {
+            recenter_scratch_.emplace_back(PriceAt(i), slots_[i]);
+            slots_[i] = 0;
+        });
+        occupied_.ClearAll();
+        window_levels_ = 0;
+        best_ = Window();
+
+        PlaceAnchor(best_price);
+        for (const auto& level : recenter_scratch_) {
+            Place(level.price, level.quantity);
+        }
+        // Overflow keys ascend, so the ones now inside the window are a prefix
+        while (!overflow_.empty()) {
+            auto it = overflow_.begin();
+            if (static_cast<size_t>((it->first - Key(anchor_)) / Tick()) >= Window()) break;
+            Place(Key(it->first), it->second);
+            overflow_.erase(it);
+        }
+
+        for (auto& tracked : depths_) Recompute(tracked);
+        if (indexed_) RebuildIndex();
+    }
+
+    // Anchor so that `best_price` sits a quarter of the window from slot 0
+    void PlaceAnchor(Price best_price) {
+        Price headroom = static_cast<Price>(Window() / 4) * Tick();
+        anchor_ = Key(Key(best_price) - headroom);
+    }
+
+    // Raw write of a non-empty level at or behind the anchor, used while
+    // rebuilding; depth sums and indexes are left for the caller
+    void Place(Price price, Quantity quantity) {
+        size_t index = static_cast<size_t>((Key(price) - Key(anchor_)) / Tick());
+        if (index >= Window()) {
+            // Keys arrive ascending when rebuilding best-first; a wrong
+            // hint only costs a regular lookup
+            overflow_.emplace_hint(overflow_.end(), Key(price), quantity)->second = quantity;
+            return;
+        }
+        if (slots_[index] == 0) {
+            occupied_.Set(index);
+            ++window_levels_;
+            if (index < best_) best_ = index;
+        }
+        slots_[index] = quantity;
+    }
+
+    void RebuildIndex() {
+        cum_qty_.Build([&](size_t i) { return slots_[i]; });
+        cum_notional_.Build([&](size_t i) {
+            return slots_[i] != 0 ? static_cast<Notional>(slots_[i]) * PriceAt(i) : 0;
+        });
+    }
+
+    struct Fill {
+        Price worst_price;
+        Notional notional;  // Of exactly the requested quantity
+    };
+
+    /**
+     * Take `quantity` best-first; nullopt if the side is too thin.
+     */
+    std::optional<Fill> SweepTo(Quantity quantity) const {
+        if (quantity <= 0) return std::nullopt;
+
+        Quantity taken = 0;
+        Notional notional = 0;
+        auto take = [&](Price price, Quantity available) {
+            Quantity used = std::min(available, quantity - taken);
+            taken += used;
+            notional += static_cast<Notional>(used) * price;
+            return taken == quantity;
+        };
+
+        if (indexed_) {
+            size_t last = cum_qty_.LowerBound(quantity);
+            if (last < Window()) {
+                Price price = PriceAt(last);
+                Quantity before = cum_qty_.PrefixSum(last);
+                return Fill{price, cum_notional_.PrefixSum(last) +
+                                   static_cast<Notional>(quantity - before) * price};
+            }
+            taken = cum_qty_.PrefixSum(Window());
+            notional = cum_notional_.PrefixSum(Window());
+        } else {
+            for (size_t i = best_; i < Window(); i = occupied_.FindNext(i + 1)) {
+                if (take(PriceAt(i), slots_[i])) return Fill{PriceAt(i), notional};
+            }
+        }
+
+        for (const auto& [key, available] : overflow_) {
+            if (take(Key(key), available)) return Fill{Key(key), notional};
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Running total of the best `depth` levels. `boundary` is the slot of
+     * the worst included level; once that level would sit in the overflow
+     * map the sum is `spilled` and recomputed on each change until the
+     * window holds enough levels again.
+     */
+    struct DepthSum {
+        size_t depth;
+        Quantity sum;
+        size_t count;     // min(depth, LevelCount())
+        size_t boundary;  // Valid when count > 0 && !spilled
+        bool spilled;
+    };
+
+    const DepthSum* FindDepth(size_t depth) const {
+        for (const auto& tracked : depths_) {
+            if (tracked.depth == depth) return &tracked;
+        }
+        return nullptr;
+    }
+
+    void Recompute(DepthSum& tracked) {
+        tracked.sum = 0;
+        tracked.count = 0;
+        tracked.spilled = false;
+
+        // best_ may still point at a slot that was just emptied
+        size_t i = occupied_.FindNext(best_);
+        for (; i < Window() && tracked.count < tracked.depth; i = occupied_.FindNext(i + 1)) {
+            tracked.sum += slots_[i];
+            tracked.boundary = i;
+            ++tracked.count;
+        }
+        for (auto it = overflow_.begin();
+             it != overflow_.end() && tracked.count < tracked.depth; ++it) {
+            tracked.sum += it->second;
+            ++tracked.count;
+            tracked.spilled = true;
+        }
+    }
+
+    void OnSlotChanged(size_t index, Quantity old, Quantity quantity) {
+        for (auto& tracked : depths_) {
+            if (tracked.spilled) {
+                Recompute(tracked);
+            } else if (old != 0 && quantity != 0) {
+                if (index <= tracked.boundary) tracked.sum += quantity - old;
+            } else if (quantity != 0) {
+                InsertIntoDepth(tracked, index, quantity);
+            } else {
+                RemoveFromDepth(tracked, index, old);
+            }
+        }
+    }
+
+    void InsertIntoDepth(DepthSum& tracked, size_t index, Quantity quantity) {
+        if (tracked.count < tracked.depth) {
+            // Not spilled and short of depth: every level is included
+            tracked.sum += quantity;
+            if (tracked.count == 0 || index > tracked.boundary) tracked.boundary = index;
+            ++tracked.count;
+        } else if (index < tracked.boundary) {
+            // New level pushes the old boundary level out
+            tracked.sum += quantity - slots_[tracked.boundary];
+            tracked.boundary = occupied_.FindPrev(tracked.boundary - 1);
+        }
+    }
+
+    void RemoveFromDepth(DepthSum& tracked, size_t index, Quantity old) {
+        if (index > tracked.boundary) return;
+
+        tracked.sum -= old;
+        size_t next = occupied_.FindNext(tracked.boundary + 1);
+        if (next < Window()) {
+            // Next deeper level moves into range
+            tracked.sum += slots_[next];
+            tracked.boundary = next;
+        } else if (!overflow_.empty()) {
+            Recompute(tracked);
+        } else if (--tracked.count > 0 && index == tracked.boundary) {
+            tracked.boundary = occupied_.FindPrev(index);
+        }
+    }
+
+    void OnOverflowChanged() {
+        for (auto& tracked : depths_) {
+            // Overflow levels are deeper than any in-window boundary
+            if (tracked.spilled || tracked.count < tracked.depth) Recompute(tracked);
+        }
+    }
+
+    Side side_;
+    [[no_unique_address]] Geometry geometry_;
+
+    Price anchor_ = 0;             // Price of slot 0
+    std::vector<Quantity> slots_;  // Quantity per tick, 0 = empty
+    OccupancyBitmap occupied_;     // Bit per non-empty slot
+    size_t best_;                  // Index of best level, Window() if none
+    size_t window_levels_ = 0;
+
+    // Levels past the window, keyed by Key(price) so begin() is best.
+    // The pool is heap-held so the ladder stays movable.
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> overflow_pool_;
+    OverflowMap overflow_;
+
+    std::vector<PriceLevel> recenter_scratch_;  // Window levels during Recenter()
+
+    std::vector<DepthSum> depths_;
+
+    // Cumulative indexes over slots, maintained when indexed_
+    bool indexed_ = false;
+    FenwickTree<Quantity> cum_qty_;
+    FenwickTree<Notional> cum_notional_;
+};
+
+// Runtime-configured ladder used by OrderBook
+using PriceLadder = BasicPriceLadder<DynamicLadderGeometry>;
+
+}  // namespace hft
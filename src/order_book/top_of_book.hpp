@@ -0,0 +1,102 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace hft {
+
+/**
+ * Best bid/ask as seen by the book at one point in time.
+ * An empty side has price and quantity 0.
+ */
+struct TopOfBook {
+    Price bid_price = 0;
+    Quantity bid_quantity = 0;
+    Price ask_price = 0;
+    Quantity ask_quantity = 0;
+    int64_t sequence = 0;     // Exchange update id that produced this top
+    Timestamp timestamp = 0;  // NowNanos() at publication
+
+    bool operator==(const TopOfBook&) const = default;
+};
+
+/**
+ * Single-writer, multi-reader seqlock around a TopOfBook.
+ *
+ * The writer bumps the version to odd, stores the fields and bumps it
+ * back to even; it never waits. Readers copy the fields and retry if the
+ * version was odd or moved while they were copying. Fields are relaxed
+ * atomics so the racy copy is well-defined; on x86-64 the stores are
+ * plain movs.
+ *
+ * Occupies its own cache line so readers polling it do not false-share
+ * with the writer's book state.
+ */
+class alignas(64) SeqlockTopOfBook {
+public:
+    /**
+     * Writer thread only.
+     */
+    void Publish(const TopOfBook& top) {
+        uint64_t version = version_.load(std::memory_order_relaxed);
+        version_.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        bid_price_.store(top.bid_price, std::memory_order_relaxed);
+        bid_quantity_.store(top.bid_quantity, std::memory_order_relaxed);
+        ask_price_.store(top.ask_price, std::memory_order_relaxed);
+        ask_quantity_.store(top.ask_quantity, std::memory_order_relaxed);
+        sequence_.store(top.sequence, std::memory_order_relaxed);
+        timestamp_.store(top.timestamp, std::memory_order_relaxed);
+
+        version_.store(version + 2, std::memory_order_release);
+    }
+
+    /**
+     * Single attempt; returns false if a publish was in progress.
+     */
+    bool TryRead(TopOfBook& out) const {
+        uint64_t before = version_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+
+        out.bid_price = bid_price_.load(std::memory_order_relaxed);
+        out.bid_quantity = bid_quantity_.load(std::memory_order_relaxed);
+        out.ask_price = ask_price_.load(std::memory_order_relaxed);
+        out.ask_quantity = ask_quantity_.load(std::memory_order_relaxed);
+        out.sequence = sequence_.load(std::memory_order_relaxed);
+        out.timestamp = timestamp_.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version_.load(std::memory_order_relaxed) == before;
+    }
+
+    /**
+     * Consistent copy; spins only while the writer is mid-publish.
+     */
+    TopOfBook Read() const {
+        TopOfBook top;
+        while (!TryRead(top)) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        return top;
+    }
+
+    // Number of completed publishes
+    uint64_t Version() const {
+        return version_.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    std::atomic<uint64_t> version_{0};
+    std::atomic<Price> bid_price_{0};
+    std::atomic<Quantity> bid_quantity_{0};
+    std::atomic<Price> ask_price_{0};
+    std::atomic<Quantity> ask_quantity_{0};
+    std::atomic<int64_t> sequence_{0};
+    std::atomic<Timestamp> timestamp_{0};
+};
+
+}  // namespace hft
@@ -136,30 +136,22 @@ private:
 /**
  * Imbalance Strategy
  * Generates signals based on order book imbalance.
+ * Reads top-N totals from the book; call book.TrackDepth(depth) at setup
+ * to make that O(1).
  */
 class ImbalanceStrategy : public Strategy {
 public:
-    explicit ImbalanceStrategy(double imbalance_threshold = 0.3, int depth = 5)
+    explicit ImbalanceStrategy(double imbalance_threshold = 0.3, size_t depth = 5)
         : imbalance_threshold_(imbalance_threshold)
         , depth_(depth)
         , name_("Imbalance") {}
     
     void OnOrderBookUpdate(const OrderBook& book) override {
-        auto bids = book.GetTopLevels(Side::kBuy, depth_);
-        auto asks = book.GetTopLevels(Side::kSell, depth_);
+        if (book.GetLevelCount(Side::kBuy) == 0 || book.GetLevelCount(Side::kSell) == 0) return;
         
-        if (bids.empty() || asks.empty()) return;
-        
-        // Calculate total quantity on each side
-        Quantity bid_qty = 0;
-        Quantity ask_qty = 0;
-        
-        for (const auto& level : bids) {
-            bid_qty += level.quantity;
-        }
-        for (const auto& level : asks) {
-            ask_qty += level.quantity;
-        }
+        // Total quantity on each side
+        Quantity bid_qty = book.GetDepthQuantity(Side::kBuy, depth_);
+        Quantity ask_qty = book.GetDepthQuantity(Side::kSell, depth_);
         
         if (bid_qty == 0 && ask_qty == 0) return;
         
@@ -197,6 +189,7 @@ public:
     
     const std::string& GetName() const override { return name_; }
     
+    size_t GetDepth() const { return depth_; }
     double GetCurrentImbalance() const { return last_imbalance_; }
 
 private:
@@ -207,7 +200,7 @@ private:
     }
     
     double imbalance_threshold_;
-    int depth_;
+    size_t depth_;
     std::string name_;
     
     double last_imbalance_ = 0.0;
@@ -0,0 +1,81 @@
+#include "book_manager.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace hft;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                 \
+            std::exit(1);                                                  \
+        }                                                                  \
+    } while (0)
+
+// Every batch must leave the SoA row equal to what the book reports
+void CheckRow(const BookManager& manager, SymbolId id) {
+    const OrderBook& book = manager.Book(id);
+    CHECK(manager.BestBids()[id] == book.GetBestBid().value_or(BookManager::kNoPrice));
+    CHECK(manager.BestAsks()[id] == book.GetBestAsk().value_or(BookManager::kNoPrice));
+    CHECK(manager.BidDepthQuantities()[id] ==
+          book.GetDepthQuantity(Side::kBuy, manager.TrackedDepth()));
+    CHECK(manager.AskDepthQuantities()[id] ==
+          book.GetDepthQuantity(Side::kSell, manager.TrackedDepth()));
+}
+
+void TestBatchesMoveTop(size_t tracked_depth) {
+    BookManager manager(tracked_depth);
+    SymbolId btc = manager.AddSymbol("BTCUSDT");
+    SymbolId eth = manager.AddSymbol("ETHUSDT");
+
+    std::vector<LevelDelta> bids = {{10000, 5}, {9990, 3}};
+    std::vector<LevelDelta> asks = {{10010, 4}, {10020, 2}};
+    manager.ApplyBatch(btc, bids, asks);
+    CHECK(manager.BestBids()[btc] == 10000);
+    CHECK(manager.BestAsks()[btc] == 10010);
+    CHECK(manager.BestBids()[eth] == BookManager::kNoPrice);
+    CheckRow(manager, btc);
+
+    // New best on both sides
+    bids = {{10005, 1}};
+    asks = {{10008, 1}};
+    manager.ApplyBatch(btc, bids, asks);
+    CHECK(manager.BestBids()[btc] == 10005);
+    CHECK(manager.BestAsks()[btc] == 10008);
+    CheckRow(manager, btc);
+
+    // Pull the touch: the next level becomes best
+    bids = {{10005, 0}};
+    asks = {{10008, 0}};
+    manager.ApplyBatch(btc, bids, asks);
+    CHECK(manager.BestBids()[btc] == 10000);
+    CHECK(manager.BestAsks()[btc] == 10010);
+    CheckRow(manager, btc);
+
+    // One side only
+    bids = {};
+    asks = {{10010, 0}};
+    manager.ApplyBatch(btc, bids, asks);
+    CHECK(manager.BestBids()[btc] == 10000);
+    CHECK(manager.BestAsks()[btc] == 10020);
+    CheckRow(manager, btc);
+
+    // Empty a side
+    bids = {{10000, 0}, {9990, 0}};
+    asks = {};
+    manager.ApplyBatch(btc, bids, asks);
+    CHECK(manager.BestBids()[btc] == BookManager::kNoPrice);
+    CHECK(manager.BestAsks()[btc] == 10020);
+    CheckRow(manager, btc);
+}
+
+int main() {
+    TestBatchesMoveTop(0);   // Depth tracking disabled
+    TestBatchesMoveTop(1);
+    TestBatchesMoveTop(10);
+
+    std::printf("book_manager_test passed\n");
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "book_synchronizer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+using namespace hft;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                 \
+            std::exit(1);                                                  \
+        }                                                                  \
+    } while (0)
+
+std::string Snapshot(int64_t last_update_id, const char* bids) {
+    return std::string("{\"lastUpdateId\":") + std::to_string(last_update_id) +
+           ",\"bids\":" + bids + ",\"asks\":[]}";
+}
+
+struct Harness {
+    BookManager books;
+    SymbolId id = books.AddSymbol("btcusdt", 2, 8);
+    std::vector<LevelDelta> bid{{0, 0}};
+
+    DepthDeltas Diff(int64_t first, int64_t final, Price price) {
+        bid[0] = LevelDelta{price, 1};
+        DepthDeltas update;
+        update.symbol_id = id;
+        update.first_update_id = first;
+        update.final_update_id = final;
+        update.bids = bid;
+        return update;
+    }
+};
+
+void WaitFor(const std::atomic<int>& counter, int value) {
+    while (counter.load() < value) std::this_thread::yield();
+}
+
+// Initial sync, then a gap resynced in place; one worker serves both fetches
+void TestSyncAndResync() {
+    Harness h;
+    std::vector<std::string> bodies = {Snapshot(100, "[[\"1.00\",\"1\"]]"),
+                                       Snapshot(130, "[[\"2.00\",\"1\"]]")};
+    std::atomic<int> fetches{0};
+    std::atomic<int> ready{0};
+    std::atomic<bool> release_second{false};
+    std::thread::id worker;
+    BookSynchronizer sync(h.books, h.id, [&](const std::atomic<bool>&) {
+        if (fetches == 0) worker = std::this_thread::get_id();
+        CHECK(worker == std::this_thread::get_id());
+        while (fetches == 1 && !release_second) std::this_thread::yield();
+        return bodies.at(static_cast<size_t>(fetches++));
+    }, 8);
+    sync.SetOnReady([&]() { ++ready; });
+
+    sync.OnDiff(h.Diff(95, 101, 150));
+    WaitFor(ready, 1);
+    CHECK(sync.Poll() && sync.IsLive());
+    CHECK(sync.GetLastUpdateId() == 101);
+
+    CHECK(sync.OnDiff(h.Diff(102, 105, 160)));
+    CHECK(!sync.OnDiff(h.Diff(110, 112, 170)));  // 106..109 missed
+    CHECK(sync.IsStale());
+    CHECK(sync.GetGapCount() == 1 && sync.GetMissedUpdateCount() == 4);
+    CHECK(!sync.OnDiff(h.Diff(113, 131, 180)));
+
+    release_second = true;
+    WaitFor(ready, 2);
+    CHECK(sync.Poll() && sync.IsLive());
+    CHECK(sync.GetLastUpdateId() == 131);
+    CHECK(sync.GetSnapshotCount() == 2);
+    CHECK(sync.OnDiff(h.Diff(132, 133, 190)));
+}
+
+// A failed fetch is counted and reported, then retried
+void TestFetchFailure() {
+    Harness h;
+    std::atomic<int> ready{0};
+    BookSynchronizer sync(h.books, h.id, [](const std::atomic<bool>&) -> std::string {
+        throw std::runtime_error("connection refused");
+    });
+    sync.SetOnReady([&]() { ++ready; });
+
+    sync.OnDiff(h.Diff(95, 101, 150));
+    WaitFor(ready, 1);
+    CHECK(!sync.Poll());
+    CHECK(sync.GetFetchFailureCount() == 1);
+    CHECK(sync.GetLastError() == "connection refused");
+}
+
+// Snapshots that never bridge the buffer are refetched with backoff, not
+// back to back, and are not counted as failures
+void TestRefetchBackoff() {
+    Harness h;
+    std::atomic<int> fetches{0};
+    std::atomic<int> ready{0};
+    BookSynchronizer sync(h.books, h.id, [&](const std::atomic<bool>&) {
+        ++fetches;
+        return Snapshot(50, "[[\"1.00\",\"1\"]]");  // Always older than the buffer
+    });
+    sync.SetOnReady([&]() { ++ready; });
+
+    sync.OnDiff(h.Diff(95, 101, 150));
+    WaitFor(ready, 1);
+    CHECK(!sync.Poll());  // Unbridged: first refetch goes out at once
+    CHECK(sync.GetRefetchCount() == 1);
+    WaitFor(ready, 2);
+    CHECK(!sync.Poll());  // Second in a row: backs off
+    CHECK(sync.GetRefetchCount() == 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(!sync.Poll());
+    CHECK(fetches == 2);
+
+    std::this_thread::sleep_for(std::chrono::nanoseconds(BookSynchronizer::kRefetchDelayNanos));
+    CHECK(!sync.Poll());  // Backoff over: fetch again
+    WaitFor(ready, 3);
+    CHECK(fetches == 3);
+    CHECK(!sync.Poll());
+    CHECK(sync.GetSnapshotCount() == 3 && sync.GetRefetchCount() == 3);
+    CHECK(sync.GetFetchFailureCount() == 0);
+}
+
+// Teardown cancels a fetch stuck on the network instead of waiting it out
+void TestDestructorCancelsFetch() {
+    Harness h;
+    std::atomic<int> started{0};
+    std::atomic<int> ready{0};
+    auto sync = std::make_unique<BookSynchronizer>(
+        h.books, h.id, [&](const std::atomic<bool>& cancel) -> std::string {
+            ++started;
+            auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+            while (!cancel.load() && std::chrono::steady_clock::now() < give_up) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            throw std::runtime_error("cancelled");
+        });
+    sync->SetOnReady([&]() { ++ready; });
+
+    sync->OnDiff(h.Diff(95, 101, 150));
+    WaitFor(started, 1);
+    auto begin = std::chrono::steady_clock::now();
+    sync.reset();
+    CHECK(std::chrono::steady_clock::now() - begin < std::chrono::seconds(5));
+    CHECK(ready == 0);  // No completion posted for an abandoned fetch
+}
+
+int main() {
+    TestSyncAndResync();
+    TestFetchFailure();
+    TestRefetchBackoff();
+    TestDestructorCancelsFetch();
+
+    std::printf("book_synchronizer_test passed\n");
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "fixed_point.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+using namespace hft;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                 \
+            std::exit(1);                                                  \
+        }                                                                  \
+    } while (0)
+
+// Digit-by-digit reference with overflow checks on every step
+bool ReferenceParse(const std::string& s, int decimals, int64_t& out) {
+    size_t i = 0;
+    bool negative = !s.empty() && s[0] == '-';
+    if (negative) ++i;
+    __extension__ __int128 value = 0;
+    int frac = -1;
+    size_t digits = 0;
+    for (; i < s.size(); ++i) {
+        char c = s[i];
+        if (c == '.' && frac < 0) { frac = 0; continue; }
+        if (c < '0' || c > '9') return false;
+        ++digits;
+        if (frac >= 0) {
+            if (frac >= decimals) {
+                if (c != '0') return false;
+                continue;
+            }
+            ++frac;
+        }
+        value = value * 10 + (c - '0');
+        if (value > INT64_MAX) return false;
+    }
+    if (digits == 0) return false;
+    for (int k = frac < 0 ? 0 : frac; k < decimals; ++k) {
+        value *= 10;
+        if (value > INT64_MAX) return false;
+    }
+    out = static_cast<int64_t>(negative ? -value : value);
+    return true;
+}
+
+int main() {
+    int64_t value = 0;
+
+    // Binance-shaped input whose scaled value does not fit in int64
+    CHECK(!ParseFixed("12345678.12345678", 12, value));
+    CHECK(!ParseFixed("99999999.00000000", 18, value));
+    CHECK(ParseFixed("12345678.12345678", 8, value) && value == 1234567812345678LL);
+    CHECK(ParseFixed("30000.50000000", 2, value) && value == 3000050);
+    CHECK(ParseFixed("-0.00000001", 8, value) && value == -1);
+
+    // decimals outside kPow10
+    CHECK(!ParseFixed("1.5", -1, value));
+    CHECK(!ParseFixed("1.5", 19, value));
+    CHECK(ParseFixed("1", 18, value) && value == 1000000000000000000LL);
+
+    // FormatFixed clamps decimals instead of reading past kPow10
+    CHECK(FormatFixed(3000050, 2).View() == "30000.50");
+    CHECK(FormatFixed(-5, 0).View() == "-5.");
+    CHECK(FormatFixed(7, -3).View() == "7.");
+    CHECK(FormatFixed(INT64_MIN, 40).View() == "-9.223372036854775808");
+    CHECK(FormatFixed(INT64_MAX, 19).View().size() <= kMaxFixedChars);
+
+    // Differential check against the reference
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<int> int_len(0, 12);
+    std::uniform_int_distribution<int> frac_len(0, 12);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> decimals(0, 18);
+    for (int n = 0; n < 1000000; ++n) {
+        std::string s;
+        if (gen() % 4 == 0) s += '-';
+        int a = int_len(gen);
+        int b = frac_len(gen);
+        for (int k = 0; k < a; ++k) s += static_cast<char>('0' + digit(gen));
+        if (b > 0 || gen() % 2) s += '.';
+        for (int k = 0; k < b; ++k) s += static_cast<char>('0' + (gen() % 3 ? digit(gen) : 0));
+        int d = decimals(gen);
+
+        int64_t expected = 0;
+        int64_t actual = 0;
+        bool expected_ok = ReferenceParse(s, d, expected);
+        bool actual_ok = ParseFixed(s, d, actual);
+        if (expected_ok != actual_ok || (expected_ok && expected != actual)) {
+            std::fprintf(stderr, "mismatch: \"%s\" decimals=%d\n", s.c_str(), d);
+            return 1;
+        }
+    }
+
+    std::printf("fixed_point_test passed\n");
+    return 0;
+}
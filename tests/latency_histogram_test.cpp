@@ -0,0 +1,65 @@
+#include "latency_histogram.hpp"
+#include "latency_stats.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace hft;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                 \
+            std::exit(1);                                                  \
+        }                                                                  \
+    } while (0)
+
+bool Near(double actual, double expected, double tolerance) {
+    return std::fabs(actual - expected) <= expected * tolerance + 1;
+}
+
+int main() {
+    LatencyHistogram empty("Empty");
+    CHECK(empty.Calculate().count == 0);
+
+    // Small values land in exact buckets
+    LatencyHistogram exact("Exact");
+    for (int64_t v = 0; v < 50; ++v) exact.Record(v);
+    auto small = exact.Calculate();
+    CHECK(small.count == 50);
+    CHECK(small.min_ns == 0 && small.max_ns == 49);
+    CHECK(small.median_ns == 25);
+    CHECK(small.p90_ns == 45);
+
+    // Percentiles within bucket precision of the exact, sorted answer
+    LatencyHistogram histogram("Histogram");
+    LatencyStats reference("Reference", 200000);
+    std::mt19937_64 gen(7);
+    std::lognormal_distribution<double> latency(8.0, 1.5);  // ~3 us median, long tail
+    for (int i = 0; i < 200000; ++i) {
+        auto v = static_cast<int64_t>(latency(gen));
+        histogram.Record(v);
+        reference.Record(v);
+    }
+    auto h = histogram.Calculate();
+    auto r = reference.Calculate();
+    CHECK(h.count == r.count);
+    CHECK(h.min_ns == r.min_ns && h.max_ns == r.max_ns);
+    CHECK(Near(h.mean_ns, r.mean_ns, 1e-9));
+    CHECK(Near(h.median_ns, r.median_ns, 0.04));
+    CHECK(Near(h.p90_ns, r.p90_ns, 0.04));
+    CHECK(Near(h.p99_ns, r.p99_ns, 0.04));
+    CHECK(Near(h.p999_ns, r.p999_ns, 0.04));
+
+    // Out-of-range samples are clamped, not dropped
+    LatencyHistogram extreme("Extreme");
+    extreme.Record(-5);
+    extreme.Record(INT64_MAX);
+    auto e = extreme.Calculate();
+    CHECK(e.count == 2 && e.min_ns == 0 && e.max_ns == static_cast<double>(INT64_MAX));
+
+    std::printf("latency_histogram_test passed\n");
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "price_ladder.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+
+using namespace hft;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,    \
+                         __LINE__, #cond);                                 \
+            std::exit(1);                                                  \
+        }                                                                  \
+    } while (0)
+
+// Count heap allocations to check the steady-state update path
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using Reference = std::map<Price, Quantity, std::function<bool(Price, Price)>>;
+
+Reference MakeReference(Side side) {
+    if (side == Side::kBuy) return Reference([](Price a, Price b) { return a > b; });
+    return Reference([](Price a, Price b) { return a < b; });
+}
+
+void CheckEqual(const PriceLadder& ladder, const Reference& reference, size_t depth) {
+    CHECK(ladder.LevelCount() == reference.size());
+    if (reference.empty()) {
+        CHECK(!ladder.BestPrice());
+        return;
+    }
+    CHECK(ladder.BestPrice() == reference.begin()->first);
+
+    Quantity expected_depth = 0;
+    size_t n = 0;
+    for (auto it = reference.begin(); it != reference.end() && n < depth; ++it, ++n) {
+        expected_depth += it->second;
+    }
+    CHECK(ladder.DepthQuantity(depth) == expected_depth);
+
+    auto it = reference.begin();
+    bool same = true;
+    ladder.ForEach(reference.size(), [&](Price price, Quantity quantity) {
+        same &= it != reference.end() && it->first == price && it->second == quantity;
+        ++it;
+    });
+    CHECK(same && it == reference.end());
+}
+
+// Random updates around a drifting mid, in a window small enough that the
+// touch keeps re-centring and deep levels keep moving through the overflow
+void TestAgainstReference(Side side) {
+    for (Price tick : {1, 5}) {
+        PriceLadder ladder(side, DynamicLadderGeometry(tick, 256));
+        ladder.TrackDepth(10);
+        ladder.EnableCumulativeIndex();
+        Reference reference = MakeReference(side);
+
+        std::mt19937_64 gen(static_cast<uint64_t>(tick));
+        Price mid = 1'000'000;
+        for (int i = 0; i < 200000; ++i) {
+            if (i % 500 == 0) mid += static_cast<Price>(gen() % 2001) - 1000;
+            Price price = (mid + static_cast<Price>(gen() % 1201) - 600) / tick * tick;
+            Quantity quantity = gen() % 3 == 0 ? 0 : static_cast<Quantity>(gen() % 100 + 1);
+
+            Quantity expected_old = reference.count(price) ? reference[price] : 0;
+            CHECK(ladder.Set(price, quantity) == expected_old);
+            if (quantity != 0) {
+                reference[price] = quantity;
+            } else {
+                reference.erase(price);
+            }
+            if (i % 101 == 0) CheckEqual(ladder, reference, 10);
+        }
+        CheckEqual(ladder, reference, 10);
+    }
+}
+
+// Once the overflow pool and scratch buffer are warm, updates and
+// re-centres do not allocate
+void TestSteadyStateDoesNotAllocate() {
+    PriceLadder ladder(Side::kSell, DynamicLadderGeometry(1, 256));
+    ladder.TrackDepth(10);
+
+    // Warm up: every price in the range live at once, the peak footprint
+    constexpr Price kLow = 100'000;
+    constexpr Price kRange = 4096;
+    for (Price price = kLow; price < kLow + kRange; ++price) ladder.Set(price, 1);
+
+    std::mt19937_64 gen(42);
+    size_t before = g_allocations.load();
+    for (int i = 0; i < 200000; ++i) {
+        Price price = kLow + static_cast<Price>(gen() % kRange);
+        ladder.Set(price, gen() % 2 == 0 ? 0 : static_cast<Quantity>(gen() % 50 + 1));
+    }
+    CHECK(g_allocations.load() == before);
+}
+
+int main() {
+    TestAgainstReference(Side::kBuy);
+    TestAgainstReference(Side::kSell);
+    TestSteadyStateDoesNotAllocate();
+
+    std::printf("price_ladder_test passed\n");
+    return 0;
+}